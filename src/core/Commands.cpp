@@ -116,9 +116,7 @@ void RemoveObjectsCommand::undo()
 
 void RemoveObjectsCommand::redo()
 {
-    for (auto* obj : m_objects) {
-        m_document->removeObjectDirect(obj);
-    }
+    m_document->removeObjectsDirect(m_objects);
     m_ownsObjects = true;
 }
 
@@ -306,15 +304,15 @@ void ModifyHandleCommand::undo()
     if (!m_object) return;
 
     if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_object)) {
-        auto vertices = polyline->vertices();
-        if (m_vertexIndex >= 0 && m_vertexIndex < vertices.size()) {
-            vertices[m_vertexIndex].tangent = m_oldTangent;
+        if (m_vertexIndex >= 0 && m_vertexIndex < polyline->vertexCount()) {
+            Geometry::PolylineVertex vertex = polyline->vertexAt(m_vertexIndex);
+            vertex.tangent = m_oldTangent;
             if (m_side < 0) {
-                vertices[m_vertexIndex].incomingTension = m_oldTension;
+                vertex.incomingTension = m_oldTension;
             } else {
-                vertices[m_vertexIndex].outgoingTension = m_oldTension;
+                vertex.outgoingTension = m_oldTension;
             }
-            polyline->setVertices(vertices);
+            polyline->editVertices().setVertex(m_vertexIndex, vertex);
         }
     }
 }
@@ -324,15 +322,15 @@ void ModifyHandleCommand::redo()
     if (!m_object) return;
 
     if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_object)) {
-        auto vertices = polyline->vertices();
-        if (m_vertexIndex >= 0 && m_vertexIndex < vertices.size()) {
-            vertices[m_vertexIndex].tangent = m_newTangent;
+        if (m_vertexIndex >= 0 && m_vertexIndex < polyline->vertexCount()) {
+            Geometry::PolylineVertex vertex = polyline->vertexAt(m_vertexIndex);
+            vertex.tangent = m_newTangent;
             if (m_side < 0) {
-                vertices[m_vertexIndex].incomingTension = m_newTension;
+                vertex.incomingTension = m_newTension;
             } else {
-                vertices[m_vertexIndex].outgoingTension = m_newTension;
+                vertex.outgoingTension = m_newTension;
             }
-            polyline->setVertices(vertices);
+            polyline->editVertices().setVertex(m_vertexIndex, vertex);
         }
     }
 }
@@ -428,7 +426,7 @@ QVariant UpdatePropertyCommand::getProperty(Geometry::GeometryObject* object, co
             return circle->radius();
         }
     } else if (auto* polyline = dynamic_cast<Geometry::Polyline*>(object)) {
-        auto vertices = polyline->vertices();
+        const auto& vertices = polyline->vertices();
         if (!vertices.isEmpty()) {
             if (propertyName == "x") {
                 return vertices.first().position.x();
@@ -501,20 +499,12 @@ void UpdatePropertyCommand::setProperty(Geometry::GeometryObject* object, const
             circle->setRadius(value.toDouble());
         }
     } else if (auto* polyline = dynamic_cast<Geometry::Polyline*>(object)) {
-        auto vertices = polyline->vertices();
+        const auto& vertices = polyline->vertices();
         if (!vertices.isEmpty()) {
             if (propertyName == "x") {
-                double dx = value.toDouble() - vertices.first().position.x();
-                for (auto& v : vertices) {
-                    v.position.setX(v.position.x() + dx);
-                }
-                polyline->setVertices(vertices);
+                polyline->translate(QPointF(value.toDouble() - vertices.position(0).x(), 0.0));
             } else if (propertyName == "y") {
-                double dy = value.toDouble() - vertices.first().position.y();
-                for (auto& v : vertices) {
-                    v.position.setY(v.position.y() + dy);
-                }
-                polyline->setVertices(vertices);
+                polyline->translate(QPointF(0.0, value.toDouble() - vertices.position(0).y()));
             }
         }
     }
@@ -536,19 +526,21 @@ RotateObjectsCommand::RotateObjectsCommand(const QList<Geometry::GeometryObject*
 void RotateObjectsCommand::undo()
 {
     // Undo rotation by rotating back with negative angle
+    QTransform matrix = Geometry::GeometryObject::rotationTransform(-m_angleDegrees, m_center);
     for (auto* obj : m_objects) {
         if (obj) {
-            obj->rotate(-m_angleDegrees, m_center);
+            obj->transform(matrix);
         }
     }
 }
 
 void RotateObjectsCommand::redo()
 {
-    // Apply rotation
+    // Apply rotation, one precomputed matrix for all objects
+    QTransform matrix = Geometry::GeometryObject::rotationTransform(m_angleDegrees, m_center);
     for (auto* obj : m_objects) {
         if (obj) {
-            obj->rotate(m_angleDegrees, m_center);
+            obj->transform(matrix);
         }
     }
 }
@@ -677,7 +669,7 @@ MirrorObjectsCommand::~MirrorObjectsCommand()
         // Check if first object is in document
         bool inDocument = false;
         if (!m_mirroredObjects.isEmpty() && m_document) {
-            inDocument = m_document->objects().contains(m_mirroredObjects.first());
+            inDocument = m_document->containsObject(m_mirroredObjects.first());
         }
         if (!inDocument) {
             qDeleteAll(m_mirroredObjects);
@@ -700,13 +692,14 @@ void MirrorObjectsCommand::redo()
     if (m_firstRedo) {
         // First execution: create the mirrored copies
         m_mirroredObjects.clear();
+        QTransform matrix = Geometry::GeometryObject::mirrorTransform(m_axisPoint1, m_axisPoint2);
         for (auto* original : m_originalObjects) {
             if (original) {
                 // Clone the object
                 auto* mirrored = cloneObject(original);
                 if (mirrored) {
                     // Mirror the clone
-                    mirrored->mirror(m_axisPoint1, m_axisPoint2);
+                    mirrored->transform(matrix);
                     // Add to document
                     m_document->addObjectDirect(mirrored);
                     // Store the mirrored object
@@ -746,9 +739,10 @@ ScaleObjectsCommand::ScaleObjectsCommand(const QList<Geometry::GeometryObject*>&
 void ScaleObjectsCommand::undo()
 {
     // Undo scale by scaling with inverse factors
+    QTransform matrix = Geometry::GeometryObject::scaleTransform(1.0 / m_scaleX, 1.0 / m_scaleY, m_origin);
     for (auto* obj : m_objects) {
         if (obj) {
-            obj->scale(1.0 / m_scaleX, 1.0 / m_scaleY, m_origin);
+            obj->transform(matrix);
         }
     }
 }
@@ -756,10 +750,11 @@ void ScaleObjectsCommand::undo()
 void ScaleObjectsCommand::redo()
 {
     qDebug() << "ScaleObjectsCommand::redo - scaleX=" << m_scaleX << "scaleY=" << m_scaleY << "origin=" << m_origin;
-    // Apply scale
+    // Apply scale, one precomputed matrix for all objects
+    QTransform matrix = Geometry::GeometryObject::scaleTransform(m_scaleX, m_scaleY, m_origin);
     for (auto* obj : m_objects) {
         if (obj) {
-            obj->scale(m_scaleX, m_scaleY, m_origin);
+            obj->transform(matrix);
         }
     }
 }
@@ -1324,10 +1319,7 @@ ScalePatternCommand::ScalePatternCommand(Geometry::Polyline* polyline,
     setText(QObject::tr("Scale Pattern (%1% × %2%)").arg(scaleX * 100, 0, 'f', 0).arg(scaleY * 100, 0, 'f', 0));
     
     // Save original vertex positions
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    for (const auto& v : vertices) {
-        m_oldPositions.append(v.position);
-    }
+    m_oldPositions = m_polyline->vertices().positions();
     
     // Save seam allowance width
     if (m_polyline->seamAllowance()) {
@@ -1347,11 +1339,12 @@ ScalePatternCommand::~ScalePatternCommand()
 void ScalePatternCommand::undo()
 {
     // Restore vertex positions
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    for (int i = 0; i < vertices.size() && i < m_oldPositions.size(); ++i) {
-        vertices[i].position = m_oldPositions[i];
+    {
+        auto edit = m_polyline->editVertices();
+        for (int i = 0; i < edit.size() && i < m_oldPositions.size(); ++i) {
+            edit.setPosition(i, m_oldPositions[i]);
+        }
     }
-    m_polyline->setVertices(vertices);
     
     // Restore seam allowance width
     if (m_scaleSeamAllowance && m_polyline->seamAllowance()) {
@@ -1374,14 +1367,14 @@ void ScalePatternCommand::redo()
     QPointF origin = bounds.center();
     
     // Scale vertex positions around origin
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    for (int i = 0; i < vertices.size(); ++i) {
-        QPointF pos = vertices[i].position;
-        QPointF offset = pos - origin;
-        QPointF scaledOffset(offset.x() * m_scaleX, offset.y() * m_scaleY);
-        vertices[i].position = origin + scaledOffset;
-    }
-    m_polyline->setVertices(vertices);
+    {
+        auto edit = m_polyline->editVertices();
+        for (int i = 0; i < edit.size(); ++i) {
+            QPointF offset = edit.at(i).position - origin;
+            QPointF scaledOffset(offset.x() * m_scaleX, offset.y() * m_scaleY);
+            edit.setPosition(i, origin + scaledOffset);
+        }
+    }
     
     // Scale seam allowance width
     if (m_scaleSeamAllowance && m_polyline->seamAllowance()) {
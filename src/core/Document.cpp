@@ -9,6 +9,8 @@
 #include "geometry/GeometryObject.h"
 #include "io/NativeFormat.h"
 #include <QDebug>
+#include <QPair>
+#include <algorithm>
 
 namespace PatternCAD {
 
@@ -16,13 +18,17 @@ Document::Document(QObject* parent)
     : QObject(parent)
     , m_name("Untitled")
     , m_modified(false)
+    , m_nextSelectionOrder(0)
+    , m_selectedListValid(true)
     , m_activeLayer("Default")
     , m_undoStack(new QUndoStack(this))
+    , m_zOrderHoles(0)
+    , m_objectListValid(true)
+    , m_batchDepth(0)
+    , m_flushScheduled(false)
 {
     // Add default layer with black color
-    m_layers.append("Default");
-    m_layerVisibility["Default"] = true;
-    m_layerColors["Default"] = Qt::black;
+    resetLayers();
 
     // Connect undo stack signals to document modified state
     connect(m_undoStack, &QUndoStack::indexChanged, this, [this]() {
@@ -33,8 +39,7 @@ Document::Document(QObject* parent)
 Document::~Document()
 {
     // Cleanup objects
-    qDeleteAll(m_objects);
-    m_objects.clear();
+    clearObjects();
 }
 
 QString Document::name() const
@@ -65,7 +70,7 @@ void Document::setModified(bool modified)
 
 void Document::addObject(Geometry::GeometryObject* object)
 {
-    if (object && !m_objects.contains(object)) {
+    if (object && !containsObject(object)) {
         // Assign object to active layer
         object->setLayer(m_activeLayer);
 
@@ -77,7 +82,7 @@ void Document::addObject(Geometry::GeometryObject* object)
 
 void Document::removeObject(Geometry::GeometryObject* object)
 {
-    if (object && m_objects.contains(object)) {
+    if (object && containsObject(object)) {
         // Use command for undo/redo support
         RemoveObjectCommand* cmd = new RemoveObjectCommand(this, object);
         m_undoStack->push(cmd);
@@ -93,7 +98,7 @@ void Document::removeObjects(const QList<Geometry::GeometryObject*>& objects)
     // Filter to only include objects that are in the document
     QList<Geometry::GeometryObject*> validObjects;
     for (auto* obj : objects) {
-        if (obj && m_objects.contains(obj)) {
+        if (obj && containsObject(obj)) {
             validObjects.append(obj);
         }
     }
@@ -109,44 +114,403 @@ void Document::removeObjects(const QList<Geometry::GeometryObject*>& objects)
 
 QList<Geometry::GeometryObject*> Document::objects() const
 {
-    return m_objects;
+    if (!m_objectListValid) {
+        m_objectList.clear();
+        m_objectList.reserve(m_objectEntries.size());
+        for (Geometry::GeometryObject* obj : m_zOrder) {
+            if (obj) {
+                m_objectList.append(obj);
+            }
+        }
+        m_objectListValid = true;
+    }
+    return m_objectList;
+}
+
+int Document::objectCountOnLayer(const QString& layerName) const
+{
+    int id = layerId(layerName);
+    return (id >= 0) ? m_layerTable[id].objects.size() : objectsOnLayer(layerName).size();
+}
+
+bool Document::containsObject(Geometry::GeometryObject* object) const
+{
+    return m_objectEntries.contains(object);
+}
+
+int Document::objectCount() const
+{
+    return m_objectEntries.size();
+}
+
+Document::ObjectHandle Document::objectHandle(Geometry::GeometryObject* object) const
+{
+    ObjectHandle handle;
+    auto it = m_objectEntries.constFind(object);
+    if (it != m_objectEntries.constEnd()) {
+        handle.slot = it->slot;
+        handle.generation = m_slots[it->slot].generation;
+    }
+    return handle;
+}
+
+Geometry::GeometryObject* Document::resolveHandle(const ObjectHandle& handle) const
+{
+    if (handle.slot < 0 || handle.slot >= m_slots.size() ||
+        m_slots[handle.slot].generation != handle.generation) {
+        return nullptr;
+    }
+    return m_slots[handle.slot].object;
+}
+
+Geometry::GeometryObject* Document::objectById(const QString& id) const
+{
+    return m_objectsById.value(id, nullptr);
 }
 
 QList<Geometry::GeometryObject*> Document::objectsOnLayer(const QString& layerName) const
 {
+    int id = layerId(layerName);
+    if (id < 0) {
+        // Not in the layer table: objects carry the name only
+        QList<Geometry::GeometryObject*> result;
+        for (auto* obj : objects()) {
+            if (obj && obj->layer() == layerName) {
+                result.append(obj);
+            }
+        }
+        return result;
+    }
+
+    // In z-order, like objects()
+    QVector<QPair<int, Geometry::GeometryObject*>> ordered;
+    ordered.reserve(m_layerTable[id].objects.size());
+    for (Geometry::GeometryObject* obj : m_layerTable[id].objects) {
+        ordered.append(qMakePair(m_objectEntries.value(obj).zIndex, obj));
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
     QList<Geometry::GeometryObject*> result;
+    result.reserve(ordered.size());
+    for (const auto& entry : ordered) {
+        result.append(entry.second);
+    }
+    return result;
+}
 
-    for (auto* obj : m_objects) {
-        if (obj && obj->layer() == layerName) {
-            result.append(obj);
-        }
+QList<Geometry::GeometryObject*> Document::objectsAt(const QPointF& point, double tolerance) const
+{
+    return objectsForProxies(m_spatialIndex.queryPoint(point, tolerance));
+}
+
+QList<Geometry::GeometryObject*> Document::objectsInRect(const QRectF& rect) const
+{
+    return objectsForProxies(m_spatialIndex.query(rect));
+}
+
+QList<Geometry::GeometryObject*> Document::nearestObjects(const QPointF& point, int count) const
+{
+    QList<Geometry::GeometryObject*> result;
+    for (int proxy : m_spatialIndex.nearest(point, count)) {
+        result.append(static_cast<Geometry::GeometryObject*>(m_spatialIndex.userData(proxy)));
     }
+    return result;
+}
 
+QRectF Document::objectsBounds() const
+{
+    return m_spatialIndex.totalBounds();
+}
+
+QList<Geometry::GeometryObject*> Document::objectsForProxies(const QVector<int>& proxies) const
+{
+    QVector<QPair<int, Geometry::GeometryObject*>> ordered;
+    ordered.reserve(proxies.size());
+    for (int proxy : proxies) {
+        auto* object = static_cast<Geometry::GeometryObject*>(m_spatialIndex.userData(proxy));
+        ordered.append(qMakePair(m_objectEntries.value(object).zIndex, object));
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    QList<Geometry::GeometryObject*> result;
+    result.reserve(ordered.size());
+    for (const auto& entry : ordered) {
+        result.append(entry.second);
+    }
     return result;
 }
 
+void Document::indexObject(Geometry::GeometryObject* object)
+{
+    ObjectEntry entry;
+    entry.proxy = m_spatialIndex.insert(object->boundingRect(), object);
+
+    if (m_freeSlots.isEmpty()) {
+        m_slots.append(ObjectSlot{nullptr, 0});
+        entry.slot = m_slots.size() - 1;
+    } else {
+        entry.slot = m_freeSlots.takeLast();
+    }
+    m_slots[entry.slot].object = object;
+
+    entry.zIndex = m_zOrder.size();
+    m_zOrder.append(object);
+    if (m_objectListValid) {
+        m_objectList.append(object);
+    }
+
+    entry.layerId = layerId(object->layer());
+    if (entry.layerId >= 0) {
+        m_layerTable[entry.layerId].objects.insert(object);
+    }
+
+    entry.id = object->id();
+    m_objectsById.insert(entry.id, object);
+
+    m_objectEntries.insert(object, entry);
+}
+
+void Document::unindexObject(Geometry::GeometryObject* object)
+{
+    auto it = m_objectEntries.find(object);
+    if (it == m_objectEntries.end()) {
+        return;
+    }
+
+    m_spatialIndex.remove(it->proxy);
+
+    // Invalidate outstanding handles
+    ObjectSlot& slot = m_slots[it->slot];
+    slot.object = nullptr;
+    ++slot.generation;
+    m_freeSlots.append(it->slot);
+
+    m_zOrder[it->zIndex] = nullptr;
+    ++m_zOrderHoles;
+    m_objectListValid = false;
+
+    if (it->layerId >= 0) {
+        m_layerTable[it->layerId].objects.remove(object);
+    }
+    if (m_objectsById.value(it->id) == object) {
+        m_objectsById.remove(it->id);
+    }
+
+    m_objectEntries.erase(it);
+    m_dirtyObjects.remove(object);
+
+    if (m_zOrderHoles > m_zOrder.size() / 2) {
+        compactZOrder();
+    }
+}
+
+void Document::reindexObject(Geometry::GeometryObject* object)
+{
+    auto it = m_objectEntries.find(object);
+    if (it != m_objectEntries.end()) {
+        m_spatialIndex.update(it->proxy, object->boundingRect());
+
+        // Objects keep their id unless assigned one (e.g. when loading)
+        if (it->id != object->id()) {
+            if (m_objectsById.value(it->id) == object) {
+                m_objectsById.remove(it->id);
+            }
+            it->id = object->id();
+            m_objectsById.insert(it->id, object);
+        }
+    }
+}
+
+void Document::compactZOrder()
+{
+    int count = 0;
+    for (int i = 0; i < m_zOrder.size(); ++i) {
+        Geometry::GeometryObject* obj = m_zOrder[i];
+        if (obj) {
+            m_objectEntries[obj].zIndex = count;
+            m_zOrder[count++] = obj;
+        }
+    }
+    m_zOrder.resize(count);
+    m_zOrderHoles = 0;
+}
+
+void Document::clearObjects()
+{
+    const QList<Geometry::GeometryObject*> allObjects = objects();
+    qDeleteAll(allObjects);
+
+    m_selection.clear();
+    m_selectedList.clear();
+    m_selectedListValid = true;
+    m_spatialIndex.clear();
+    m_objectEntries.clear();
+    m_dirtyObjects.clear();
+    m_dirtyOrder.clear();
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_zOrder.clear();
+    m_zOrderHoles = 0;
+    m_objectsById.clear();
+    m_objectList.clear();
+    m_objectListValid = true;
+}
+
 QList<Geometry::GeometryObject*> Document::selectedObjects() const
 {
-    return m_selectedObjects;
+    if (!m_selectedListValid) {
+        QVector<QPair<quint64, Geometry::GeometryObject*>> ordered;
+        ordered.reserve(m_selection.size());
+        for (auto it = m_selection.constBegin(); it != m_selection.constEnd(); ++it) {
+            ordered.append(qMakePair(it.value(), it.key()));
+        }
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        m_selectedList.clear();
+        m_selectedList.reserve(ordered.size());
+        for (const auto& entry : ordered) {
+            m_selectedList.append(entry.second);
+        }
+        m_selectedListValid = true;
+    }
+    return m_selectedList;
+}
+
+bool Document::isSelected(Geometry::GeometryObject* object) const
+{
+    return m_selection.contains(object);
+}
+
+int Document::selectionCount() const
+{
+    return m_selection.size();
 }
 
 void Document::setSelectedObjects(const QList<Geometry::GeometryObject*>& objects)
 {
-    m_selectedObjects = objects;
-    emit selectionChanged();
+    QHash<Geometry::GeometryObject*, quint64> selection;
+    selection.reserve(objects.size());
+    QList<Geometry::GeometryObject*> list;
+    QList<Geometry::GeometryObject*> added;
+    for (auto* obj : objects) {
+        if (obj && !selection.contains(obj)) {
+            selection.insert(obj, list.size());
+            list.append(obj);
+            if (!m_selection.contains(obj)) {
+                added.append(obj);
+            }
+        }
+    }
+
+    QList<Geometry::GeometryObject*> removed;
+    for (auto it = m_selection.constBegin(); it != m_selection.constEnd(); ++it) {
+        if (!selection.contains(it.key())) {
+            removed.append(it.key());
+        }
+    }
+
+    m_selection = selection;
+    m_nextSelectionOrder = list.size();
+    m_selectedList = list;
+    m_selectedListValid = true;
+    notifySelectionDelta(added, removed);
+}
+
+void Document::select(const QList<Geometry::GeometryObject*>& objects)
+{
+    QList<Geometry::GeometryObject*> added;
+    for (auto* obj : objects) {
+        if (obj && !m_selection.contains(obj)) {
+            m_selection.insert(obj, m_nextSelectionOrder++);
+            if (m_selectedListValid) {
+                m_selectedList.append(obj);
+            }
+            added.append(obj);
+        }
+    }
+    notifySelectionDelta(added, QList<Geometry::GeometryObject*>());
+}
+
+void Document::deselect(const QList<Geometry::GeometryObject*>& objects)
+{
+    QList<Geometry::GeometryObject*> removed;
+    for (auto* obj : objects) {
+        if (m_selection.remove(obj)) {
+            removed.append(obj);
+        }
+    }
+    if (!removed.isEmpty()) {
+        m_selectedListValid = false;
+    }
+    notifySelectionDelta(QList<Geometry::GeometryObject*>(), removed);
 }
 
 void Document::clearSelection()
 {
-    if (!m_selectedObjects.isEmpty()) {
-        m_selectedObjects.clear();
-        emit selectionChanged();
+    if (!m_selection.isEmpty()) {
+        QList<Geometry::GeometryObject*> removed = selectedObjects();
+        m_selection.clear();
+        m_selectedList.clear();
+        m_selectedListValid = true;
+        notifySelectionDelta(QList<Geometry::GeometryObject*>(), removed);
     }
 }
 
 void Document::selectAll()
 {
-    m_selectedObjects = m_objects;
+    // Selection order becomes z-order
+    QList<Geometry::GeometryObject*> all = objects();
+    QList<Geometry::GeometryObject*> added;
+    QHash<Geometry::GeometryObject*, quint64> selection;
+    selection.reserve(all.size());
+    for (auto* obj : all) {
+        selection.insert(obj, selection.size());
+        if (!m_selection.contains(obj)) {
+            added.append(obj);
+        }
+    }
+
+    // Selected objects that are not in the document stay selected
+    QList<Geometry::GeometryObject*> extra;
+    for (auto* obj : selectedObjects()) {
+        if (!selection.contains(obj)) {
+            extra.append(obj);
+        }
+    }
+    for (auto* obj : extra) {
+        selection.insert(obj, selection.size());
+    }
+
+    m_selection = selection;
+    m_nextSelectionOrder = selection.size();
+    m_selectedList = all + extra;
+    m_selectedListValid = true;
+    notifySelectionDelta(added, QList<Geometry::GeometryObject*>());
+}
+
+void Document::notifySelectionDelta(const QList<Geometry::GeometryObject*>& added,
+                                    const QList<Geometry::GeometryObject*>& removed)
+{
+    if (added.isEmpty() && removed.isEmpty()) {
+        return;
+    }
+
+    for (auto* obj : removed) {
+        obj->setSelected(false);
+    }
+    for (auto* obj : added) {
+        obj->setSelected(true);
+    }
+
+    if (!removed.isEmpty()) {
+        emit objectsDeselected(removed);
+    }
+    if (!added.isEmpty()) {
+        emit objectsSelected(added);
+    }
     emit selectionChanged();
 }
 
@@ -157,10 +521,9 @@ QStringList Document::layers() const
 
 void Document::addLayer(const QString& layerName, const QColor& color)
 {
-    if (!m_layers.contains(layerName)) {
-        m_layers.append(layerName);
-        m_layerVisibility[layerName] = true;
-        m_layerColors[layerName] = color.isValid() ? color : Qt::black;
+    if (!m_layerIds.contains(layerName)) {
+        int id = allocateLayer(layerName, color.isValid() ? color : QColor(Qt::black));
+        adoptLayerObjects(id);
         emit layerAdded(layerName);
         notifyModified();
     }
@@ -168,19 +531,27 @@ void Document::addLayer(const QString& layerName, const QColor& color)
 
 void Document::removeLayer(const QString& layerName)
 {
-    if (m_layers.contains(layerName) && m_layers.size() > 1) {
+    int id = layerId(layerName);
+    if (id >= 0 && m_layers.size() > 1) {
         m_layers.removeAll(layerName);
-        m_layerVisibility.remove(layerName);
-        m_layerColors.remove(layerName);
 
         // Move objects from removed layer to first layer
         QString targetLayer = m_layers.first();
-        for (auto* obj : m_objects) {
-            if (obj && obj->layer() == layerName) {
-                obj->setLayer(targetLayer);
-            }
+        const QSet<Geometry::GeometryObject*> layerObjects = m_layerTable[id].objects;
+        for (auto* obj : layerObjects) {
+            obj->setLayer(targetLayer);
         }
 
+        // Free the slot for reuse
+        m_layerIds.remove(layerName);
+        LayerEntry& layer = m_layerTable[id];
+        layer.name.clear();
+        layer.color = Qt::black;
+        layer.visible = true;
+        layer.locked = false;
+        layer.inUse = false;
+        layer.objects.clear();
+
         emit layerRemoved(layerName);
 
         // If active layer was removed, switch to first layer
@@ -195,25 +566,20 @@ void Document::removeLayer(const QString& layerName)
 void Document::renameLayer(const QString& oldName, const QString& newName)
 {
     int index = m_layers.indexOf(oldName);
-    if (index >= 0 && !m_layers.contains(newName)) {
+    if (index >= 0 && !m_layerIds.contains(newName)) {
         m_layers[index] = newName;
 
-        // Update visibility map
-        bool visible = m_layerVisibility.value(oldName, true);
-        m_layerVisibility.remove(oldName);
-        m_layerVisibility[newName] = visible;
-
-        // Update color map
-        QColor color = m_layerColors.value(oldName, Qt::black);
-        m_layerColors.remove(oldName);
-        m_layerColors[newName] = color;
+        // The layer keeps its id; only the name changes
+        int id = m_layerIds.take(oldName);
+        m_layerIds.insert(newName, id);
+        m_layerTable[id].name = newName;
 
         // Update objects on this layer
-        for (auto* obj : m_objects) {
-            if (obj && obj->layer() == oldName) {
-                obj->setLayer(newName);
-            }
+        const QSet<Geometry::GeometryObject*> layerObjects = m_layerTable[id].objects;
+        for (auto* obj : layerObjects) {
+            obj->setLayer(newName);
         }
+        adoptLayerObjects(id);
 
         emit layerRenamed(oldName, newName);
 
@@ -241,17 +607,18 @@ void Document::setActiveLayer(const QString& layerName)
 
 bool Document::isLayerVisible(const QString& layerName) const
 {
-    return m_layerVisibility.value(layerName, true);
+    return isLayerVisible(layerId(layerName));
 }
 
 void Document::setLayerVisible(const QString& layerName, bool visible)
 {
-    qDebug() << "Document::setLayerVisible - layer:" << layerName << "visible:" << visible << "contains:" << m_layers.contains(layerName);
-    if (m_layers.contains(layerName)) {
-        bool oldVisible = m_layerVisibility.value(layerName, true);
+    int id = layerId(layerName);
+    qDebug() << "Document::setLayerVisible - layer:" << layerName << "visible:" << visible << "contains:" << (id >= 0);
+    if (id >= 0) {
+        bool oldVisible = m_layerTable[id].visible;
         qDebug() << "  oldVisible:" << oldVisible << "new:" << visible;
         if (oldVisible != visible) {
-            m_layerVisibility[layerName] = visible;
+            m_layerTable[id].visible = visible;
             qDebug() << "  Emitting layerVisibilityChanged signal";
             emit layerVisibilityChanged(layerName, visible);
         }
@@ -260,34 +627,127 @@ void Document::setLayerVisible(const QString& layerName, bool visible)
 
 QColor Document::layerColor(const QString& layerName) const
 {
-    return m_layerColors.value(layerName, Qt::black);
+    return layerColor(layerId(layerName));
 }
 
 void Document::setLayerColor(const QString& layerName, const QColor& color)
 {
-    if (m_layers.contains(layerName) && color.isValid()) {
-        m_layerColors[layerName] = color;
-        emit layerVisibilityChanged(layerName, m_layerVisibility.value(layerName, true));
+    int id = layerId(layerName);
+    if (id >= 0 && color.isValid()) {
+        m_layerTable[id].color = color;
+        emit layerVisibilityChanged(layerName, m_layerTable[id].visible);
         notifyModified();
     }
 }
 
 bool Document::isLayerLocked(const QString& layerName) const
 {
-    return m_layerLocked.value(layerName, false);
+    return isLayerLocked(layerId(layerName));
 }
 
 void Document::setLayerLocked(const QString& layerName, bool locked)
 {
-    if (m_layers.contains(layerName)) {
-        bool oldLocked = m_layerLocked.value(layerName, false);
-        if (oldLocked != locked) {
-            m_layerLocked[layerName] = locked;
-            notifyModified();
+    int id = layerId(layerName);
+    if (id >= 0 && m_layerTable[id].locked != locked) {
+        m_layerTable[id].locked = locked;
+        emit layerLockChanged(layerName, locked);
+        notifyModified();
+    }
+}
+
+int Document::layerId(const QString& layerName) const
+{
+    return m_layerIds.value(layerName, -1);
+}
+
+int Document::objectLayerId(Geometry::GeometryObject* object) const
+{
+    auto it = m_objectEntries.constFind(object);
+    return (it != m_objectEntries.constEnd()) ? it->layerId : layerId(object->layer());
+}
+
+QString Document::layerName(int layerId) const
+{
+    return (layerId >= 0 && layerId < m_layerTable.size()) ? m_layerTable[layerId].name : QString();
+}
+
+bool Document::isLayerVisible(int layerId) const
+{
+    return (layerId >= 0 && layerId < m_layerTable.size()) ? m_layerTable[layerId].visible : true;
+}
+
+QColor Document::layerColor(int layerId) const
+{
+    return (layerId >= 0 && layerId < m_layerTable.size()) ? m_layerTable[layerId].color : QColor(Qt::black);
+}
+
+bool Document::isLayerLocked(int layerId) const
+{
+    return (layerId >= 0 && layerId < m_layerTable.size()) ? m_layerTable[layerId].locked : false;
+}
+
+int Document::allocateLayer(const QString& layerName, const QColor& color)
+{
+    int id = 0;
+    while (id < m_layerTable.size() && m_layerTable[id].inUse) {
+        ++id;
+    }
+    if (id == m_layerTable.size()) {
+        m_layerTable.append(LayerEntry());
+    }
+
+    LayerEntry& layer = m_layerTable[id];
+    layer.name = layerName;
+    layer.color = color;
+    layer.visible = true;
+    layer.locked = false;
+    layer.inUse = true;
+    layer.objects.clear();
+
+    m_layerIds.insert(layerName, id);
+    m_layers.append(layerName);
+    return id;
+}
+
+void Document::updateObjectLayer(Geometry::GeometryObject* object)
+{
+    auto it = m_objectEntries.find(object);
+    if (it == m_objectEntries.end()) {
+        return;
+    }
+
+    int id = layerId(object->layer());
+    if (id != it->layerId) {
+        if (it->layerId >= 0) {
+            m_layerTable[it->layerId].objects.remove(object);
+        }
+        if (id >= 0) {
+            m_layerTable[id].objects.insert(object);
         }
+        it->layerId = id;
     }
 }
 
+void Document::adoptLayerObjects(int layerId)
+{
+    // Objects that already named this layer before it entered the table
+    const QString& name = m_layerTable[layerId].name;
+    for (auto it = m_objectEntries.begin(); it != m_objectEntries.end(); ++it) {
+        if (it->layerId < 0 && it.key()->layer() == name) {
+            it->layerId = layerId;
+            m_layerTable[layerId].objects.insert(it.key());
+        }
+    }
+}
+
+void Document::resetLayers()
+{
+    m_layerTable.clear();
+    m_layerIds.clear();
+    m_layers.clear();
+    allocateLayer("Default", Qt::black);
+}
+
 bool Document::save(const QString& filepath)
 {
     IO::NativeFormat format;
@@ -315,23 +775,17 @@ bool Document::load(const QString& filepath)
 void Document::clear()
 {
     // Clear all objects
-    qDeleteAll(m_objects);
-    m_objects.clear();
-    m_selectedObjects.clear();
+    clearObjects();
 
     // Reset layers to default
-    m_layers.clear();
-    m_layerVisibility.clear();
-    m_layerColors.clear();
-    m_layers.append("Default");
-    m_layerVisibility["Default"] = true;
-    m_layerColors["Default"] = Qt::black;
+    resetLayers();
     m_activeLayer = "Default";
 
     // Reset document properties
     m_name = "Untitled";
     setModified(false);
 
+    emit cleared();
     emit selectionChanged();
 }
 
@@ -346,6 +800,7 @@ void Document::notifyModified()
 void Document::undo()
 {
     if (m_undoStack->canUndo()) {
+        ChangeBatch batch(this);
         m_undoStack->undo();
     }
 }
@@ -353,6 +808,7 @@ void Document::undo()
 void Document::redo()
 {
     if (m_undoStack->canRedo()) {
+        ChangeBatch batch(this);
         m_undoStack->redo();
     }
 }
@@ -370,14 +826,13 @@ bool Document::canRedo() const
 // Direct operations (used by commands - do not use directly!)
 void Document::addObjectDirect(Geometry::GeometryObject* object)
 {
-    if (object && !m_objects.contains(object)) {
-        m_objects.append(object);
+    if (object && !containsObject(object)) {
+        indexObject(object);
 
         // Connect object's changed signal
         connect(object, &Geometry::GeometryObject::changed,
                 this, [this, object]() {
-            emit objectChanged(object);
-            notifyModified();
+            objectChangedInternal(object);
         });
 
         emit objectAdded(object);
@@ -386,19 +841,120 @@ void Document::addObjectDirect(Geometry::GeometryObject* object)
 
 void Document::removeObjectDirect(Geometry::GeometryObject* object)
 {
-    if (object && m_objects.contains(object)) {
-        m_objects.removeAll(object);
-        m_selectedObjects.removeAll(object);
+    if (object && containsObject(object)) {
+        unindexObject(object);
+        disconnect(object, &Geometry::GeometryObject::changed, this, nullptr);
         emit objectRemoved(object);
+        emit objectsRemoved(QList<Geometry::GeometryObject*>() << object);
+
+        if (isSelected(object)) {
+            deselect(QList<Geometry::GeometryObject*>() << object);
+        }
     }
 }
 
+void Document::removeObjectsDirect(const QList<Geometry::GeometryObject*>& objects)
+{
+    QList<Geometry::GeometryObject*> removed;
+    QList<Geometry::GeometryObject*> deselected;
+    for (auto* obj : objects) {
+        if (obj && containsObject(obj)) {
+            unindexObject(obj);
+            disconnect(obj, &Geometry::GeometryObject::changed, this, nullptr);
+            removed.append(obj);
+            if (isSelected(obj)) {
+                deselected.append(obj);
+            }
+        }
+    }
+
+    for (auto* obj : removed) {
+        emit objectRemoved(obj);
+    }
+    if (!removed.isEmpty()) {
+        emit objectsRemoved(removed);
+    }
+
+    // One selection update for the whole batch
+    deselect(deselected);
+}
+
 void Document::notifyObjectChanged(Geometry::GeometryObject* object)
 {
     if (object) {
+        objectChangedInternal(object);
+    }
+}
+
+void Document::objectChangedInternal(Geometry::GeometryObject* object)
+{
+    auto it = m_objectEntries.constFind(object);
+    if (it == m_objectEntries.constEnd()) {
+        // Not in the document: nothing to index, report right away
         emit objectChanged(object);
         notifyModified();
+        return;
+    }
+
+    if (!m_dirtyObjects.contains(object)) {
+        m_dirtyObjects.insert(object, m_spatialIndex.bounds(it->proxy));
+        m_dirtyOrder.append(object);
+    }
+    reindexObject(object);
+    updateObjectLayer(object);
+    notifyModified();
+
+    if (m_batchDepth == 0 && !m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &Document::flushChanges, Qt::QueuedConnection);
+    }
+}
+
+void Document::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void Document::endBatch()
+{
+    if (m_batchDepth > 0 && --m_batchDepth == 0) {
+        flushChanges();
+    }
+}
+
+void Document::flushChanges()
+{
+    m_flushScheduled = false;
+    if (m_batchDepth > 0 || m_dirtyOrder.isEmpty()) {
+        return;
+    }
+
+    QList<Geometry::GeometryObject*> order;
+    order.swap(m_dirtyOrder);
+    QHash<Geometry::GeometryObject*, QRectF> dirty;
+    dirty.swap(m_dirtyObjects);
+
+    // Objects removed meanwhile are no longer in 'dirty'; taking each
+    // entry also drops duplicates
+    QList<Geometry::GeometryObject*> objects;
+    QRectF bounds;
+    for (auto* obj : order) {
+        auto it = dirty.find(obj);
+        if (it == dirty.end()) {
+            continue;
+        }
+        bounds |= it.value() | obj->boundingRect();
+        dirty.erase(it);
+        objects.append(obj);
+    }
+    if (objects.isEmpty()) {
+        return;
+    }
+
+    for (auto* obj : objects) {
+        emit objectChanged(obj);
     }
+    emit objectsChanged(objects, bounds);
 }
 
 } // namespace PatternCAD
@@ -11,9 +11,15 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QColor>
+#include <QPointF>
+#include <QRectF>
 #include <QUndoStack>
 #include <memory>
+#include "geometry/AABBTree.h"
 
 namespace PatternCAD {
 
@@ -49,12 +55,45 @@ public:
     void addObject(Geometry::GeometryObject* object);
     void removeObject(Geometry::GeometryObject* object);
     void removeObjects(const QList<Geometry::GeometryObject*>& objects);
-    QList<Geometry::GeometryObject*> objects() const;
+    QList<Geometry::GeometryObject*> objects() const;  // In z-order (bottom to top)
     QList<Geometry::GeometryObject*> objectsOnLayer(const QString& layerName) const;
+    int objectCountOnLayer(const QString& layerName) const;
+    bool containsObject(Geometry::GeometryObject* object) const;
+    int objectCount() const;
 
-    // Selection
+    // Stable object handles: a handle keeps resolving to its object while
+    // it is in the document, and to nullptr once it is removed (also after
+    // undo re-adds it, which issues a new handle). Lookups are O(1).
+    struct ObjectHandle {
+        int slot = -1;
+        quint32 generation = 0;
+
+        bool isNull() const { return slot < 0; }
+        bool operator==(const ObjectHandle& other) const {
+            return slot == other.slot && generation == other.generation;
+        }
+    };
+    ObjectHandle objectHandle(Geometry::GeometryObject* object) const;
+    Geometry::GeometryObject* resolveHandle(const ObjectHandle& handle) const;
+    Geometry::GeometryObject* objectById(const QString& id) const;
+
+    // Spatial queries on object bounds, backed by a bounding-box tree that is
+    // kept up to date as objects are added, removed and changed. Results are
+    // in z-order (bottom to top), except nearestObjects (closest first).
+    QList<Geometry::GeometryObject*> objectsAt(const QPointF& point, double tolerance = 0.0) const;
+    QList<Geometry::GeometryObject*> objectsInRect(const QRectF& rect) const;
+    QList<Geometry::GeometryObject*> nearestObjects(const QPointF& point, int count) const;
+    QRectF objectsBounds() const;
+
+    // Selection, a hash set kept in sync with GeometryObject::isSelected().
+    // selectedObjects() is in selection order; changes emit the objects
+    // that were deselected and selected, then selectionChanged().
     QList<Geometry::GeometryObject*> selectedObjects() const;
+    bool isSelected(Geometry::GeometryObject* object) const;
+    int selectionCount() const;
     void setSelectedObjects(const QList<Geometry::GeometryObject*>& objects);
+    void select(const QList<Geometry::GeometryObject*>& objects);
+    void deselect(const QList<Geometry::GeometryObject*>& objects);
     void clearSelection();
     void selectAll();
 
@@ -72,6 +111,16 @@ public:
     bool isLayerLocked(const QString& layerName) const;
     void setLayerLocked(const QString& layerName, bool locked);
 
+    // Interned layers: ids index the layer table and stay valid while the
+    // layer exists (renaming keeps the id). Objects on layers missing from
+    // the table have id -1, which reads as visible, unlocked and black.
+    int layerId(const QString& layerName) const;
+    int objectLayerId(Geometry::GeometryObject* object) const;
+    QString layerName(int layerId) const;
+    bool isLayerVisible(int layerId) const;
+    QColor layerColor(int layerId) const;
+    bool isLayerLocked(int layerId) const;
+
     // Undo/Redo
     QUndoStack* undoStack() const { return m_undoStack; }
     void undo();
@@ -82,10 +131,38 @@ public:
     // Direct object operations (used by commands - do not use directly)
     void addObjectDirect(Geometry::GeometryObject* object);
     void removeObjectDirect(Geometry::GeometryObject* object);
+    void removeObjectsDirect(const QList<Geometry::GeometryObject*>& objects);
 
     // Notify that an object has changed (for external modifications)
     void notifyObjectChanged(Geometry::GeometryObject* object);
 
+    // Change batching. Object changes update the document's indexes at
+    // once, but objectChanged()/objectsChanged() are coalesced: inside a
+    // batch they are emitted when the outermost batch ends, otherwise once
+    // per event loop iteration. Each object is reported once per flush.
+    void beginBatch();
+    void endBatch();
+    bool inBatch() const { return m_batchDepth > 0; }
+
+    class ChangeBatch
+    {
+    public:
+        explicit ChangeBatch(Document* document) : m_document(document) {
+            if (m_document) {
+                m_document->beginBatch();
+            }
+        }
+        ~ChangeBatch() {
+            if (m_document) {
+                m_document->endBatch();
+            }
+        }
+
+    private:
+        Q_DISABLE_COPY(ChangeBatch)
+        Document* m_document;
+    };
+
     // File operations
     bool save(const QString& filepath);
     bool load(const QString& filepath);
@@ -96,29 +173,98 @@ signals:
     void modifiedChanged(bool modified);
     void objectAdded(Geometry::GeometryObject* object);
     void objectRemoved(Geometry::GeometryObject* object);
+    void objectsRemoved(const QList<Geometry::GeometryObject*>& objects);  // Once per removal call
     void objectChanged(Geometry::GeometryObject* object);
+    void objectsChanged(const QList<Geometry::GeometryObject*>& objects, const QRectF& bounds);
     void selectionChanged();
+    void objectsSelected(const QList<Geometry::GeometryObject*>& objects);
+    void objectsDeselected(const QList<Geometry::GeometryObject*>& objects);
     void layerAdded(const QString& layerName);
     void layerRemoved(const QString& layerName);
     void layerRenamed(const QString& oldName, const QString& newName);
     void activeLayerChanged(const QString& layerName);
     void layerVisibilityChanged(const QString& layerName, bool visible);
+    void layerLockChanged(const QString& layerName, bool locked);
+    void cleared();  // All objects deleted and layers reset by clear()
 
 private:
     // Private members
     QString m_name;
     bool m_modified;
-    QList<Geometry::GeometryObject*> m_objects;
-    QList<Geometry::GeometryObject*> m_selectedObjects;
-    QStringList m_layers;
-    QMap<QString, bool> m_layerVisibility;
-    QMap<QString, bool> m_layerLocked;
-    QMap<QString, QColor> m_layerColors;
+
+    // Selection: object -> selection sequence number, and the selection
+    // sorted by it (rebuilt lazily after deselection)
+    QHash<Geometry::GeometryObject*, quint64> m_selection;
+    quint64 m_nextSelectionOrder;
+    mutable QList<Geometry::GeometryObject*> m_selectedList;
+    mutable bool m_selectedListValid;
     QString m_activeLayer;
     QUndoStack* m_undoStack;
 
+    // Layer table, indexed by layer id; slots of removed layers are reused.
+    // m_layers keeps the display order, each entry its objects.
+    struct LayerEntry {
+        QString name;
+        QColor color;
+        bool visible;
+        bool locked;
+        bool inUse;
+        QSet<Geometry::GeometryObject*> objects;
+    };
+    QVector<LayerEntry> m_layerTable;
+    QHash<QString, int> m_layerIds;
+    QStringList m_layers;
+
+    // Object store. Slots back the handles: a freed slot is reused with
+    // the next generation. The z-order list leaves a hole where an object
+    // was removed and is compacted once holes make up half of it.
+    struct ObjectSlot {
+        Geometry::GeometryObject* object;
+        quint32 generation;
+    };
+    QVector<ObjectSlot> m_slots;
+    QVector<int> m_freeSlots;
+    QVector<Geometry::GeometryObject*> m_zOrder;
+    int m_zOrderHoles;
+    QHash<QString, Geometry::GeometryObject*> m_objectsById;
+    mutable QList<Geometry::GeometryObject*> m_objectList;  // m_zOrder without holes
+    mutable bool m_objectListValid;
+
+    // Per object: spatial index proxy, slot, position in m_zOrder, layer id
+    // and the id it is filed under in m_objectsById
+    struct ObjectEntry {
+        int proxy;
+        int slot;
+        int zIndex;
+        int layerId;
+        QString id;
+    };
+    Geometry::AABBTree m_spatialIndex;
+    QHash<Geometry::GeometryObject*, ObjectEntry> m_objectEntries;
+
+    // Objects changed since the last flush, with their bounds before the
+    // first change, in order of first change (may hold stale duplicates)
+    QHash<Geometry::GeometryObject*, QRectF> m_dirtyObjects;
+    QList<Geometry::GeometryObject*> m_dirtyOrder;
+    int m_batchDepth;
+    bool m_flushScheduled;
+
     // Helper methods
     void notifyModified();
+    void indexObject(Geometry::GeometryObject* object);
+    void unindexObject(Geometry::GeometryObject* object);
+    void reindexObject(Geometry::GeometryObject* object);
+    void compactZOrder();
+    void notifySelectionDelta(const QList<Geometry::GeometryObject*>& added,
+                              const QList<Geometry::GeometryObject*>& removed);
+    void clearObjects();
+    void objectChangedInternal(Geometry::GeometryObject* object);
+    void flushChanges();
+    int allocateLayer(const QString& layerName, const QColor& color);
+    void updateObjectLayer(Geometry::GeometryObject* object);
+    void adoptLayerObjects(int layerId);
+    void resetLayers();
+    QList<Geometry::GeometryObject*> objectsForProxies(const QVector<int>& proxies) const;
 };
 
 } // namespace PatternCAD
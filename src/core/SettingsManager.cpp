@@ -119,6 +119,8 @@ void SettingsManager::loadEditor()
     m_editor.selectionLineWidth = m_settings.value("selectionLineWidth", 2.0).toDouble();
     m_editor.canvasBackgroundColor = m_settings.value("canvasBackgroundColor", QColor(Qt::white)).value<QColor>();
     m_editor.antiAliasing = m_settings.value("antiAliasing", true).toBool();
+    m_editor.curveLengthTolerance = m_settings.value("curveLengthTolerance", 0.01).toDouble();
+    m_editor.curveFlatteningTolerance = m_settings.value("curveFlatteningTolerance", 0.05).toDouble();
     m_settings.endGroup();
 }
 
@@ -135,6 +137,7 @@ void SettingsManager::loadFileIO()
     m_fileIO.lastSaveDirectory = m_settings.value("lastSaveDirectory", "").toString();
     m_fileIO.lastExportDirectory = m_settings.value("lastExportDirectory", "").toString();
     m_fileIO.compressNativeFormat = m_settings.value("compressNativeFormat", true).toBool();
+    m_fileIO.exportFlatteningTolerance = m_settings.value("exportFlatteningTolerance", 0.01).toDouble();
     m_settings.endGroup();
 }
 
@@ -173,6 +176,8 @@ void SettingsManager::saveEditor()
     m_settings.setValue("selectionLineWidth", m_editor.selectionLineWidth);
     m_settings.setValue("canvasBackgroundColor", m_editor.canvasBackgroundColor);
     m_settings.setValue("antiAliasing", m_editor.antiAliasing);
+    m_settings.setValue("curveLengthTolerance", m_editor.curveLengthTolerance);
+    m_settings.setValue("curveFlatteningTolerance", m_editor.curveFlatteningTolerance);
     m_settings.endGroup();
 }
 
@@ -189,6 +194,7 @@ void SettingsManager::saveFileIO()
     m_settings.setValue("lastSaveDirectory", m_fileIO.lastSaveDirectory);
     m_settings.setValue("lastExportDirectory", m_fileIO.lastExportDirectory);
     m_settings.setValue("compressNativeFormat", m_fileIO.compressNativeFormat);
+    m_settings.setValue("exportFlatteningTolerance", m_fileIO.exportFlatteningTolerance);
     m_settings.endGroup();
 }
 
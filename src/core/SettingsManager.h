@@ -48,6 +48,10 @@ struct EditorSettings {
     // Canvas
     QColor canvasBackgroundColor = Qt::white;
     bool antiAliasing = true;
+
+    // Curves
+    double curveLengthTolerance = 0.01;  // mm, arc-length accuracy of curved segments
+    double curveFlatteningTolerance = 0.05;  // mm, max chord deviation of curves on screen
 };
 
 /**
@@ -71,6 +75,7 @@ struct FileIOSettings {
 
     // File format
     bool compressNativeFormat = true;
+    double exportFlatteningTolerance = 0.01;  // mm, max chord deviation of exported curves
 };
 
 /**
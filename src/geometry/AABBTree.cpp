@@ -0,0 +1,412 @@
+/**
+ * AABBTree.cpp
+ *
+ * Implementation of AABBTree
+ */
+
+#include "AABBTree.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+AABBTree::AABBTree()
+    : m_root(-1)
+    , m_freeList(-1)
+    , m_leafCount(0)
+{
+}
+
+void AABBTree::clear()
+{
+    m_nodes.clear();
+    m_root = -1;
+    m_freeList = -1;
+    m_leafCount = 0;
+}
+
+int AABBTree::insert(const QRectF& bounds, void* userData)
+{
+    int leaf = allocateNode();
+    m_nodes[leaf].box = toBox(bounds);
+    m_nodes[leaf].userData = userData;
+    m_nodes[leaf].height = 0;
+    insertLeaf(leaf);
+    ++m_leafCount;
+    return leaf;
+}
+
+void AABBTree::remove(int proxy)
+{
+    if (!isValidProxy(proxy)) {
+        return;
+    }
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --m_leafCount;
+}
+
+void AABBTree::update(int proxy, const QRectF& bounds)
+{
+    if (!isValidProxy(proxy)) {
+        return;
+    }
+
+    Box box = toBox(bounds);
+    const Box& current = m_nodes[proxy].box;
+    if (box.minX == current.minX && box.minY == current.minY &&
+        box.maxX == current.maxX && box.maxY == current.maxY) {
+        return;
+    }
+
+    removeLeaf(proxy);
+    m_nodes[proxy].box = box;
+    insertLeaf(proxy);
+}
+
+void* AABBTree::userData(int proxy) const
+{
+    return isValidProxy(proxy) ? m_nodes[proxy].userData : nullptr;
+}
+
+QRectF AABBTree::bounds(int proxy) const
+{
+    if (!isValidProxy(proxy)) {
+        return QRectF();
+    }
+    const Box& box = m_nodes[proxy].box;
+    return QRectF(QPointF(box.minX, box.minY), QPointF(box.maxX, box.maxY));
+}
+
+QRectF AABBTree::totalBounds() const
+{
+    if (m_root < 0) {
+        return QRectF();
+    }
+    const Box& box = m_nodes[m_root].box;
+    return QRectF(QPointF(box.minX, box.minY), QPointF(box.maxX, box.maxY));
+}
+
+QVector<int> AABBTree::query(const QRectF& rect) const
+{
+    QVector<int> result;
+    if (m_root < 0) {
+        return result;
+    }
+
+    Box box = toBox(rect);
+    QVector<int> stack;
+    stack.append(m_root);
+    while (!stack.isEmpty()) {
+        int index = stack.takeLast();
+        const Node& node = m_nodes[index];
+        if (!overlaps(node.box, box)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            result.append(index);
+        } else {
+            stack.append(node.left);
+            stack.append(node.right);
+        }
+    }
+    return result;
+}
+
+QVector<int> AABBTree::queryPoint(const QPointF& point, double tolerance) const
+{
+    tolerance = qMax(0.0, tolerance);
+    return query(QRectF(point.x() - tolerance, point.y() - tolerance,
+                        2.0 * tolerance, 2.0 * tolerance));
+}
+
+QVector<int> AABBTree::nearest(const QPointF& point, int k) const
+{
+    QVector<int> result;
+    if (m_root < 0 || k <= 0) {
+        return result;
+    }
+
+    // Best-first search: a child's box is never closer than its parent's,
+    // so leaves come out of the queue in distance order
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    queue.push(Entry(distanceSquared(m_nodes[m_root].box, point), m_root));
+
+    while (!queue.empty() && result.size() < k) {
+        int index = queue.top().second;
+        queue.pop();
+
+        const Node& node = m_nodes[index];
+        if (node.isLeaf()) {
+            result.append(index);
+        } else {
+            queue.push(Entry(distanceSquared(m_nodes[node.left].box, point), node.left));
+            queue.push(Entry(distanceSquared(m_nodes[node.right].box, point), node.right));
+        }
+    }
+    return result;
+}
+
+int AABBTree::nearest(const QPointF& point, const std::function<double(int)>& distance,
+                      double maxDistance) const
+{
+    if (m_root < 0 || maxDistance < 0.0) {
+        return -1;
+    }
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    queue.push(Entry(distanceSquared(m_nodes[m_root].box, point), m_root));
+
+    int bestProxy = -1;
+    double bestDistance = maxDistance;
+    while (!queue.empty() && queue.top().first <= bestDistance * bestDistance) {
+        int index = queue.top().second;
+        queue.pop();
+
+        const Node& node = m_nodes[index];
+        if (node.isLeaf()) {
+            double d = distance(index);
+            if (d < bestDistance || (bestProxy < 0 && d <= bestDistance)) {
+                bestDistance = d;
+                bestProxy = index;
+            }
+        } else {
+            queue.push(Entry(distanceSquared(m_nodes[node.left].box, point), node.left));
+            queue.push(Entry(distanceSquared(m_nodes[node.right].box, point), node.right));
+        }
+    }
+    return bestProxy;
+}
+
+int AABBTree::allocateNode()
+{
+    if (m_freeList < 0) {
+        m_nodes.append(Node());
+        return m_nodes.size() - 1;
+    }
+
+    int node = m_freeList;
+    m_freeList = m_nodes[node].parent;
+    m_nodes[node] = Node();
+    return node;
+}
+
+void AABBTree::freeNode(int node)
+{
+    m_nodes[node] = Node();
+    m_nodes[node].parent = m_freeList;
+    m_freeList = node;
+}
+
+void AABBTree::insertLeaf(int leaf)
+{
+    if (m_root < 0) {
+        m_root = leaf;
+        m_nodes[leaf].parent = -1;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest perimeter cost
+    Box leafBox = m_nodes[leaf].box;
+    int index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        double area = perimeter(node.box);
+        double combined = perimeter(unite(node.box, leafBox));
+
+        // Cost of pairing the leaf with this node, and the cost every
+        // descent below it inherits from enlarging this node
+        double cost = 2.0 * combined;
+        double inheritance = 2.0 * (combined - area);
+
+        auto descentCost = [&](int child) {
+            const Box& childBox = m_nodes[child].box;
+            double enlarged = perimeter(unite(leafBox, childBox));
+            if (m_nodes[child].isLeaf()) {
+                return enlarged + inheritance;
+            }
+            return enlarged - perimeter(childBox) + inheritance;
+        };
+        double costLeft = descentCost(node.left);
+        double costRight = descentCost(node.right);
+
+        if (cost < costLeft && cost < costRight) {
+            break;
+        }
+        index = (costLeft < costRight) ? node.left : node.right;
+    }
+
+    int sibling = index;
+    int oldParent = m_nodes[sibling].parent;
+    int newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].box = unite(leafBox, m_nodes[sibling].box);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].left = sibling;
+    m_nodes[newParent].right = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent < 0) {
+        m_root = newParent;
+    } else if (m_nodes[oldParent].left == sibling) {
+        m_nodes[oldParent].left = newParent;
+    } else {
+        m_nodes[oldParent].right = newParent;
+    }
+
+    refit(m_nodes[leaf].parent);
+}
+
+void AABBTree::removeLeaf(int leaf)
+{
+    if (leaf == m_root) {
+        m_root = -1;
+        return;
+    }
+
+    int parent = m_nodes[leaf].parent;
+    int grandParent = m_nodes[parent].parent;
+    int sibling = (m_nodes[parent].left == leaf) ? m_nodes[parent].right : m_nodes[parent].left;
+
+    if (grandParent < 0) {
+        m_root = sibling;
+        m_nodes[sibling].parent = -1;
+        freeNode(parent);
+        return;
+    }
+
+    // Replace the parent by the sibling and refit the ancestors
+    if (m_nodes[grandParent].left == parent) {
+        m_nodes[grandParent].left = sibling;
+    } else {
+        m_nodes[grandParent].right = sibling;
+    }
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+void AABBTree::refit(int node)
+{
+    while (node >= 0) {
+        node = balance(node);
+
+        int left = m_nodes[node].left;
+        int right = m_nodes[node].right;
+        m_nodes[node].height = 1 + qMax(m_nodes[left].height, m_nodes[right].height);
+        m_nodes[node].box = unite(m_nodes[left].box, m_nodes[right].box);
+
+        node = m_nodes[node].parent;
+    }
+}
+
+int AABBTree::balance(int a)
+{
+    if (m_nodes[a].isLeaf() || m_nodes[a].height < 2) {
+        return a;
+    }
+
+    int b = m_nodes[a].left;
+    int c = m_nodes[a].right;
+    int heightDifference = m_nodes[c].height - m_nodes[b].height;
+
+    // Rotate the taller child up
+    auto rotateUp = [this, a](int up, int other, bool upIsRight) {
+        int first = m_nodes[up].left;
+        int second = m_nodes[up].right;
+
+        m_nodes[up].left = a;
+        m_nodes[up].parent = m_nodes[a].parent;
+        m_nodes[a].parent = up;
+
+        int upParent = m_nodes[up].parent;
+        if (upParent < 0) {
+            m_root = up;
+        } else if (m_nodes[upParent].left == a) {
+            m_nodes[upParent].left = up;
+        } else {
+            m_nodes[upParent].right = up;
+        }
+
+        // The taller grandchild stays under 'up', the other moves under 'a'
+        int keep = (m_nodes[first].height > m_nodes[second].height) ? first : second;
+        int move = (keep == first) ? second : first;
+        m_nodes[up].right = keep;
+        if (upIsRight) {
+            m_nodes[a].right = move;
+        } else {
+            m_nodes[a].left = move;
+        }
+        m_nodes[move].parent = a;
+
+        m_nodes[a].box = unite(m_nodes[other].box, m_nodes[move].box);
+        m_nodes[a].height = 1 + qMax(m_nodes[other].height, m_nodes[move].height);
+        m_nodes[up].box = unite(m_nodes[a].box, m_nodes[keep].box);
+        m_nodes[up].height = 1 + qMax(m_nodes[a].height, m_nodes[keep].height);
+        return up;
+    };
+
+    if (heightDifference > 1) {
+        return rotateUp(c, b, true);
+    }
+    if (heightDifference < -1) {
+        return rotateUp(b, c, false);
+    }
+    return a;
+}
+
+bool AABBTree::isValidProxy(int proxy) const
+{
+    return proxy >= 0 && proxy < m_nodes.size() &&
+           m_nodes[proxy].height == 0 && m_nodes[proxy].isLeaf();
+}
+
+AABBTree::Box AABBTree::toBox(const QRectF& rect)
+{
+    QRectF r = rect.normalized();
+    Box box;
+    box.minX = r.left();
+    box.minY = r.top();
+    box.maxX = r.right();
+    box.maxY = r.bottom();
+    return box;
+}
+
+AABBTree::Box AABBTree::unite(const Box& a, const Box& b)
+{
+    Box box;
+    box.minX = std::min(a.minX, b.minX);
+    box.minY = std::min(a.minY, b.minY);
+    box.maxX = std::max(a.maxX, b.maxX);
+    box.maxY = std::max(a.maxY, b.maxY);
+    return box;
+}
+
+double AABBTree::perimeter(const Box& box)
+{
+    return 2.0 * ((box.maxX - box.minX) + (box.maxY - box.minY));
+}
+
+bool AABBTree::overlaps(const Box& a, const Box& b)
+{
+    return a.minX <= b.maxX && b.minX <= a.maxX &&
+           a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+double AABBTree::distanceSquared(const Box& box, const QPointF& point)
+{
+    double dx = std::max({box.minX - point.x(), 0.0, point.x() - box.maxX});
+    double dy = std::max({box.minY - point.y(), 0.0, point.y() - box.maxY});
+    return dx * dx + dy * dy;
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
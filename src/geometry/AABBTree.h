@@ -0,0 +1,105 @@
+/**
+ * AABBTree.h
+ *
+ * Dynamic bounding-box tree for spatial queries
+ */
+
+#ifndef PATTERNCAD_AABBTREE_H
+#define PATTERNCAD_AABBTREE_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <functional>
+#include <limits>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * AABBTree is a dynamic, self-balancing binary tree of axis-aligned boxes
+ * (the structure used by Box2D's broad phase):
+ * - insert(), remove() and update() are O(log n)
+ * - query() by rectangle or point visits only overlapping subtrees
+ * - nearest() returns the k entries whose boxes are closest to a point
+ *
+ * Each entry is identified by a proxy id, stable until the entry is removed,
+ * and carries an opaque user pointer. Boxes are inclusive, so degenerate
+ * boxes (e.g. of horizontal lines) are still found.
+ */
+class AABBTree
+{
+public:
+    AABBTree();
+
+    void clear();
+
+    int insert(const QRectF& bounds, void* userData);
+    void remove(int proxy);
+    void update(int proxy, const QRectF& bounds);
+
+    int size() const { return m_leafCount; }
+    bool isEmpty() const { return m_leafCount == 0; }
+
+    void* userData(int proxy) const;
+    QRectF bounds(int proxy) const;
+
+    // Union of all boxes (null when empty)
+    QRectF totalBounds() const;
+
+    // Proxies whose boxes overlap the rectangle / lie within tolerance of the point
+    QVector<int> query(const QRectF& rect) const;
+    QVector<int> queryPoint(const QPointF& point, double tolerance = 0.0) const;
+
+    // Up to k proxies ordered by distance from the point to their boxes
+    QVector<int> nearest(const QPointF& point, int k) const;
+
+    // Proxy minimising an exact distance computed by the caller (which must
+    // be no less than the distance to the proxy's box), or -1 if none is
+    // within maxDistance. Subtrees that cannot beat the best so far are skipped.
+    int nearest(const QPointF& point, const std::function<double(int)>& distance,
+                double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+private:
+    struct Box {
+        double minX = 0.0;
+        double minY = 0.0;
+        double maxX = 0.0;
+        double maxY = 0.0;
+    };
+
+    struct Node {
+        Box box;
+        void* userData = nullptr;
+        int parent = -1;   // Also the free-list link for unused nodes
+        int left = -1;
+        int right = -1;
+        int height = -1;   // -1 for unused nodes, 0 for leaves
+
+        bool isLeaf() const { return left < 0; }
+    };
+
+    QVector<Node> m_nodes;
+    int m_root;
+    int m_freeList;
+    int m_leafCount;
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refit(int node);
+    bool isValidProxy(int proxy) const;
+
+    static Box toBox(const QRectF& rect);
+    static Box unite(const Box& a, const Box& b);
+    static double perimeter(const Box& box);
+    static bool overlaps(const Box& a, const Box& b);
+    static double distanceSquared(const Box& box, const QPointF& point);
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_AABBTREE_H
@@ -0,0 +1,118 @@
+/**
+ * ArcLengthIndex.cpp
+ *
+ * Implementation of ArcLengthIndex
+ */
+
+#include "ArcLengthIndex.h"
+#include <QtGlobal>
+
+namespace PatternCAD {
+namespace Geometry {
+
+ArcLengthIndex::ArcLengthIndex()
+    : m_highestBit(0)
+{
+}
+
+void ArcLengthIndex::clear()
+{
+    m_lengths.clear();
+    m_tree.clear();
+    m_highestBit = 0;
+}
+
+void ArcLengthIndex::build(const QVector<double>& lengths)
+{
+    int n = lengths.size();
+    m_lengths = lengths;
+    m_tree.fill(0.0, n + 1);
+
+    // Linear-time construction: push each node's sum to its parent
+    for (int i = 1; i <= n; ++i) {
+        m_tree[i] += lengths[i - 1];
+        int parent = i + (i & -i);
+        if (parent <= n) {
+            m_tree[parent] += m_tree[i];
+        }
+    }
+
+    m_highestBit = 1;
+    while (m_highestBit * 2 <= n) {
+        m_highestBit *= 2;
+    }
+    if (n == 0) {
+        m_highestBit = 0;
+    }
+}
+
+double ArcLengthIndex::lengthOf(int index) const
+{
+    if (index < 0 || index >= m_lengths.size()) {
+        return 0.0;
+    }
+    return m_lengths[index];
+}
+
+void ArcLengthIndex::setLength(int index, double length)
+{
+    if (index < 0 || index >= m_lengths.size()) {
+        return;
+    }
+
+    double delta = length - m_lengths[index];
+    m_lengths[index] = length;
+
+    int n = m_lengths.size();
+    for (int i = index + 1; i <= n; i += i & -i) {
+        m_tree[i] += delta;
+    }
+}
+
+double ArcLengthIndex::prefix(int count) const
+{
+    count = qBound(0, count, static_cast<int>(m_lengths.size()));
+
+    double sum = 0.0;
+    for (int i = count; i > 0; i -= i & -i) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+int ArcLengthIndex::find(double distance, double* offset) const
+{
+    int n = m_lengths.size();
+    if (n == 0) {
+        if (offset) *offset = 0.0;
+        return -1;
+    }
+
+    if (distance <= 0.0) {
+        if (offset) *offset = 0.0;
+        return 0;
+    }
+
+    // Binary lifting: largest 'count' with prefix(count) <= distance
+    int count = 0;
+    double remaining = distance;
+    for (int step = m_highestBit; step > 0; step >>= 1) {
+        int next = count + step;
+        if (next <= n && m_tree[next] <= remaining) {
+            count = next;
+            remaining -= m_tree[next];
+        }
+    }
+
+    // Past the end of the contour: clamp to the end of the last segment
+    if (count >= n) {
+        if (offset) *offset = m_lengths[n - 1];
+        return n - 1;
+    }
+
+    if (offset) *offset = qMin(remaining, m_lengths[count]);
+    return count;
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
@@ -0,0 +1,56 @@
+/**
+ * ArcLengthIndex.h
+ *
+ * Prefix-sum index over polyline segment lengths
+ */
+
+#ifndef PATTERNCAD_ARCLENGTHINDEX_H
+#define PATTERNCAD_ARCLENGTHINDEX_H
+
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * ArcLengthIndex stores the length of every segment of a contour in a
+ * Fenwick (binary indexed) tree:
+ * - build() is O(n)
+ * - setLength() for a single segment is O(log n)
+ * - prefix() (distance to the start of a segment) is O(log n)
+ * - find() (segment containing a distance along the contour) is O(log n)
+ */
+class ArcLengthIndex
+{
+public:
+    ArcLengthIndex();
+
+    void clear();
+    void build(const QVector<double>& lengths);
+
+    int size() const { return m_lengths.size(); }
+    bool isEmpty() const { return m_lengths.isEmpty(); }
+
+    double lengthOf(int index) const;
+    void setLength(int index, double length);
+
+    // Total length of all segments
+    double total() const { return prefix(m_lengths.size()); }
+
+    // Sum of the first 'count' segment lengths
+    double prefix(int count) const;
+
+    // Segment containing 'distance' (clamped to the contour); the distance
+    // from the start of that segment is returned in 'offset'
+    int find(double distance, double* offset = nullptr) const;
+
+private:
+    QVector<double> m_lengths;
+    QVector<double> m_tree;  // 1-based Fenwick tree
+    int m_highestBit;        // Highest power of two <= size, for find()
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_ARCLENGTHINDEX_H
@@ -190,6 +190,16 @@ void Circle::scale(double scaleX, double scaleY, const QPointF& origin)
     setRadius(m_radius * avgScale);
 }
 
+void Circle::transform(const QTransform& matrix)
+{
+    setCenter(matrix.map(m_center));
+
+    // Scale the radius by the average axis scale, as scale() does
+    double scaleX = qSqrt(matrix.m11() * matrix.m11() + matrix.m12() * matrix.m12());
+    double scaleY = qSqrt(matrix.m21() * matrix.m21() + matrix.m22() * matrix.m22());
+    setRadius(m_radius * (scaleX + scaleY) / 2.0);
+}
+
 void Circle::draw(QPainter* painter, const QColor& color) const
 {
     if (!m_visible) {
@@ -240,6 +240,17 @@ QRectF CubicBezier::boundingRect() const
     return path.boundingRect();
 }
 
+QRectF CubicBezier::paintBounds() const
+{
+    if (!m_selected) {
+        return GeometryObject::paintBounds();
+    }
+
+    // Selected curves also draw their control polygon and handles
+    QPainterPath path = createPath();
+    return GeometryObject::paintBounds() | path.controlPointRect().adjusted(-5.0, -5.0, 5.0, 5.0);
+}
+
 bool CubicBezier::contains(const QPointF& point) const
 {
     // Check if point is close to curve
@@ -292,6 +303,15 @@ void CubicBezier::scale(double scaleX, double scaleY, const QPointF& origin)
     notifyChanged();
 }
 
+void CubicBezier::transform(const QTransform& matrix)
+{
+    m_p0 = matrix.map(m_p0);
+    m_p1 = matrix.map(m_p1);
+    m_p2 = matrix.map(m_p2);
+    m_p3 = matrix.map(m_p3);
+    notifyChanged();
+}
+
 void CubicBezier::draw(QPainter* painter, const QColor& color) const
 {
     if (!m_visible) {
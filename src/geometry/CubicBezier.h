@@ -61,11 +61,13 @@ public:
 
     // Geometry overrides
     QRectF boundingRect() const override;
+    QRectF paintBounds() const override;
     bool contains(const QPointF& point) const override;
     void translate(const QPointF& delta) override;
     void rotate(double angleDegrees, const QPointF& center) override;
     void mirror(const QPointF& axisPoint1, const QPointF& axisPoint2) override;
     void scale(double scaleX, double scaleY, const QPointF& origin) override;
+    void transform(const QTransform& matrix) override;
 
     // Drawing
     void draw(QPainter* painter, const QColor& color = Qt::black) const override;
@@ -0,0 +1,449 @@
+/**
+ * CurveSegment.cpp
+ *
+ * Implementation of CurveSegment
+ */
+
+#include "CurveSegment.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PatternCAD {
+namespace Geometry {
+
+namespace {
+    // 5-point Gauss-Legendre nodes and weights on [-1, 1]
+    const double kNodes[5] = {
+        0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640
+    };
+    const double kWeights[5] = {
+        0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891
+    };
+
+    const int kMaxDepth = 16;          // Adaptive subdivision limit
+    const int kMaxInverseSteps = 32;   // Newton/bisection iteration limit
+    const int kClosestSamples = 8;     // Seed samples used by closestPoint on curves
+    const int kMaxClosestSteps = 8;    // Newton iteration limit for closestPoint
+    const int kMaxFlattenDepth = 10;   // At most 1024 chords per curve
+
+    double s_defaultTolerance = 0.01;  // mm
+    double s_defaultFlatteningTolerance = 0.05;  // mm
+
+    double vectorLength(const QPointF& v) {
+        return std::sqrt(v.x() * v.x() + v.y() * v.y());
+    }
+
+    double resolveTolerance(double tolerance) {
+        return tolerance > 0.0 ? tolerance : s_defaultTolerance;
+    }
+
+    // Upper bound of the distance between a cubic and its chord: 3/4 of the
+    // largest control point distance from the chord line
+    double cubicFlatness(const QPointF& p0, const QPointF& c1, const QPointF& c2, const QPointF& p1) {
+        QPointF chord = p1 - p0;
+        double chordLength = vectorLength(chord);
+        double d1, d2;
+        if (chordLength < 1e-10) {
+            d1 = vectorLength(c1 - p0);
+            d2 = vectorLength(c2 - p0);
+        } else {
+            QPointF v1 = c1 - p0;
+            QPointF v2 = c2 - p0;
+            d1 = std::abs(chord.x() * v1.y() - chord.y() * v1.x()) / chordLength;
+            d2 = std::abs(chord.x() * v2.y() - chord.y() * v2.x()) / chordLength;
+        }
+        return 0.75 * std::max(d1, d2);
+    }
+
+    void flattenCubic(const QPointF& p0, const QPointF& c1, const QPointF& c2, const QPointF& p1,
+                      double tolerance, int depth, QVector<QPointF>* points) {
+        if (depth >= kMaxFlattenDepth || cubicFlatness(p0, c1, c2, p1) <= tolerance) {
+            points->append(p1);
+            return;
+        }
+
+        // de Casteljau split at t = 0.5
+        QPointF p01 = (p0 + c1) * 0.5;
+        QPointF p12 = (c1 + c2) * 0.5;
+        QPointF p23 = (c2 + p1) * 0.5;
+        QPointF p012 = (p01 + p12) * 0.5;
+        QPointF p123 = (p12 + p23) * 0.5;
+        QPointF mid = (p012 + p123) * 0.5;
+
+        flattenCubic(p0, p01, p012, mid, tolerance, depth + 1, points);
+        flattenCubic(mid, p123, p23, p1, tolerance, depth + 1, points);
+    }
+}
+
+CurveSegment::CurveSegment()
+    : m_curve(false)
+{
+}
+
+CurveSegment::CurveSegment(const QPointF& start, const QPointF& end)
+    : m_p0(start)
+    , m_c1(start)
+    , m_c2(end)
+    , m_p1(end)
+    , m_curve(false)
+{
+}
+
+CurveSegment::CurveSegment(const QPointF& start, const QPointF& control1,
+                           const QPointF& control2, const QPointF& end)
+    : m_p0(start)
+    , m_c1(control1)
+    , m_c2(control2)
+    , m_p1(end)
+    , m_curve(true)
+{
+}
+
+double CurveSegment::defaultTolerance()
+{
+    return s_defaultTolerance;
+}
+
+void CurveSegment::setDefaultTolerance(double tolerance)
+{
+    if (tolerance > 0.0) {
+        s_defaultTolerance = tolerance;
+    }
+}
+
+double CurveSegment::defaultFlatteningTolerance()
+{
+    return s_defaultFlatteningTolerance;
+}
+
+void CurveSegment::setDefaultFlatteningTolerance(double tolerance)
+{
+    if (tolerance > 0.0) {
+        s_defaultFlatteningTolerance = tolerance;
+    }
+}
+
+QPointF CurveSegment::pointAt(double t) const
+{
+    if (!m_curve) {
+        return m_p0 + (m_p1 - m_p0) * t;
+    }
+
+    // B(t) = (1-t)^3 P0 + 3(1-t)^2 t C1 + 3(1-t) t^2 C2 + t^3 P1
+    double u = 1.0 - t;
+    double uu = u * u;
+    double tt = t * t;
+    return m_p0 * (uu * u) + m_c1 * (3.0 * uu * t) + m_c2 * (3.0 * u * tt) + m_p1 * (tt * t);
+}
+
+QPointF CurveSegment::derivativeAt(double t) const
+{
+    if (!m_curve) {
+        return m_p1 - m_p0;
+    }
+
+    // B'(t) = 3(1-t)^2 (C1-P0) + 6(1-t)t (C2-C1) + 3t^2 (P1-C2)
+    double u = 1.0 - t;
+    return (m_c1 - m_p0) * (3.0 * u * u) + (m_c2 - m_c1) * (6.0 * u * t) + (m_p1 - m_c2) * (3.0 * t * t);
+}
+
+QPointF CurveSegment::secondDerivativeAt(double t) const
+{
+    if (!m_curve) {
+        return QPointF();
+    }
+
+    // B''(t) = 6(1-t) (C2 - 2 C1 + P0) + 6t (P1 - 2 C2 + C1)
+    return (m_c2 - m_c1 * 2.0 + m_p0) * (6.0 * (1.0 - t)) + (m_p1 - m_c2 * 2.0 + m_c1) * (6.0 * t);
+}
+
+QRectF CurveSegment::boundingRect() const
+{
+    double left = qMin(m_p0.x(), m_p1.x());
+    double right = qMax(m_p0.x(), m_p1.x());
+    double top = qMin(m_p0.y(), m_p1.y());
+    double bottom = qMax(m_p0.y(), m_p1.y());
+    if (!m_curve) {
+        return QRectF(QPointF(left, top), QPointF(right, bottom));
+    }
+
+    auto include = [&](double t) {
+        if (t > 0.0 && t < 1.0) {
+            QPointF p = pointAt(t);
+            left = qMin(left, p.x());
+            right = qMax(right, p.x());
+            top = qMin(top, p.y());
+            bottom = qMax(bottom, p.y());
+        }
+    };
+
+    // Interior extrema per axis, where B'(t) / 3 = a t^2 + b t + c vanishes
+    // (roots in the cancellation-free form)
+    for (int axis = 0; axis < 2; ++axis) {
+        double p0 = axis ? m_p0.y() : m_p0.x();
+        double c1 = axis ? m_c1.y() : m_c1.x();
+        double c2 = axis ? m_c2.y() : m_c2.x();
+        double p1 = axis ? m_p1.y() : m_p1.x();
+        double a = p1 - p0 + 3.0 * (c1 - c2);
+        double b = 2.0 * (p0 - 2.0 * c1 + c2);
+        double c = c1 - p0;
+
+        if (a == 0.0) {
+            if (b != 0.0) {
+                include(-c / b);
+            }
+            continue;
+        }
+        double discriminant = b * b - 4.0 * a * c;
+        if (discriminant < 0.0) {
+            continue;
+        }
+        double q = -0.5 * (b + std::copysign(std::sqrt(discriminant), b));
+        include(q / a);
+        if (q != 0.0) {
+            include(c / q);
+        }
+    }
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+QPointF CurveSegment::tangentAt(double t) const
+{
+    QPointF d = derivativeAt(t);
+    double len = vectorLength(d);
+    if (len < 1e-10) {
+        d = m_p1 - m_p0;
+        len = vectorLength(d);
+        if (len < 1e-10) {
+            return QPointF(1, 0);
+        }
+    }
+    return d / len;
+}
+
+double CurveSegment::speedAt(double t) const
+{
+    return vectorLength(derivativeAt(t));
+}
+
+double CurveSegment::gaussLegendre(double t0, double t1) const
+{
+    double half = (t1 - t0) * 0.5;
+    double mid = (t0 + t1) * 0.5;
+    double sum = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        sum += kWeights[i] * speedAt(mid + half * kNodes[i]);
+    }
+    return sum * half;
+}
+
+double CurveSegment::integrateAdaptive(double t0, double t1, double whole,
+                                       double tolerance, int depth) const
+{
+    double mid = (t0 + t1) * 0.5;
+    double left = gaussLegendre(t0, mid);
+    double right = gaussLegendre(mid, t1);
+    double refined = left + right;
+
+    if (depth >= kMaxDepth || std::abs(refined - whole) <= tolerance) {
+        return refined;
+    }
+
+    return integrateAdaptive(t0, mid, left, tolerance * 0.5, depth + 1) +
+           integrateAdaptive(mid, t1, right, tolerance * 0.5, depth + 1);
+}
+
+double CurveSegment::integrate(double t0, double t1, double tolerance) const
+{
+    if (t0 == t1) {
+        return 0.0;
+    }
+    return integrateAdaptive(t0, t1, gaussLegendre(t0, t1), tolerance, 0);
+}
+
+double CurveSegment::length(double tolerance) const
+{
+    if (!m_curve) {
+        return vectorLength(m_p1 - m_p0);
+    }
+    return integrate(0.0, 1.0, resolveTolerance(tolerance));
+}
+
+double CurveSegment::lengthAt(double t, double tolerance) const
+{
+    t = qBound(0.0, t, 1.0);
+    if (!m_curve) {
+        return vectorLength(m_p1 - m_p0) * t;
+    }
+    return integrate(0.0, t, resolveTolerance(tolerance));
+}
+
+double CurveSegment::parameterAtLength(double length, double tolerance) const
+{
+    tolerance = resolveTolerance(tolerance);
+    return parameterAtLength(length, this->length(tolerance), tolerance);
+}
+
+double CurveSegment::parameterAtLength(double length, double total, double tolerance) const
+{
+    tolerance = resolveTolerance(tolerance);
+
+    if (total < 1e-10 || length <= 0.0) {
+        return 0.0;
+    }
+    if (length >= total) {
+        return 1.0;
+    }
+    if (!m_curve) {
+        return length / total;
+    }
+
+    // Safeguarded Newton iteration on L(t) - length = 0. The arc length at
+    // the current estimate is updated incrementally, so each step only
+    // integrates the interval between the previous and the new estimate.
+    double lo = 0.0;
+    double hi = 1.0;
+    double t = length / total;
+    double currentLength = integrate(0.0, t, tolerance);
+
+    for (int i = 0; i < kMaxInverseSteps; ++i) {
+        double error = currentLength - length;
+        if (std::abs(error) <= tolerance) {
+            break;
+        }
+
+        if (error > 0.0) {
+            hi = t;
+        } else {
+            lo = t;
+        }
+
+        double speed = speedAt(t);
+        double next = -1.0;
+        if (speed > 1e-10) {
+            next = t - error / speed;
+        }
+        if (next <= lo || next >= hi) {
+            next = (lo + hi) * 0.5;  // Fall back to bisection
+        }
+
+        currentLength += integrate(t, next, tolerance);
+        t = next;
+    }
+
+    return t;
+}
+
+double CurveSegment::parameterAtFraction(double fraction, double tolerance) const
+{
+    fraction = qBound(0.0, fraction, 1.0);
+    if (!m_curve) {
+        return fraction;
+    }
+    tolerance = resolveTolerance(tolerance);
+    return parameterAtLength(fraction * length(tolerance), tolerance);
+}
+
+double CurveSegment::fractionAtParameter(double t, double tolerance) const
+{
+    t = qBound(0.0, t, 1.0);
+    if (!m_curve) {
+        return t;
+    }
+    tolerance = resolveTolerance(tolerance);
+    double total = length(tolerance);
+    if (total < 1e-10) {
+        return t;
+    }
+    return qBound(0.0, lengthAt(t, tolerance) / total, 1.0);
+}
+
+void CurveSegment::flatten(QVector<QPointF>* points, double tolerance) const
+{
+    if (!m_curve) {
+        points->append(m_p1);
+        return;
+    }
+    if (tolerance <= 0.0) {
+        tolerance = s_defaultFlatteningTolerance;
+    }
+    flattenCubic(m_p0, m_c1, m_c2, m_p1, tolerance, 0, points);
+}
+
+QPointF CurveSegment::closestPoint(const QPointF& point, double* t, double* distance) const
+{
+    if (!m_curve) {
+        // Project onto the line
+        QPointF segment = m_p1 - m_p0;
+        double lengthSquared = segment.x() * segment.x() + segment.y() * segment.y();
+        double param = 0.0;
+        if (lengthSquared > 1e-10) {
+            QPointF toPoint = point - m_p0;
+            param = (toPoint.x() * segment.x() + toPoint.y() * segment.y()) / lengthSquared;
+            param = qBound(0.0, param, 1.0);
+        }
+        QPointF closest = m_p0 + segment * param;
+        if (t) *t = param;
+        if (distance) *distance = vectorLength(point - closest);
+        return closest;
+    }
+
+    // A coarse sampling brackets the candidates: every local minimum of the
+    // sampled distances is refined by Newton iteration on the derivative of
+    // the squared distance, g(t) = (B(t) - P) . B'(t), clamped to the segment
+    double sampleDistances[kClosestSamples + 1];
+    for (int s = 0; s <= kClosestSamples; ++s) {
+        sampleDistances[s] = vectorLength(point - pointAt(static_cast<double>(s) / kClosestSamples));
+    }
+
+    double bestDistance = std::numeric_limits<double>::max();
+    double bestT = 0.0;
+    QPointF bestPoint = m_p0;
+    for (int s = 0; s <= kClosestSamples; ++s) {
+        if ((s > 0 && sampleDistances[s - 1] < sampleDistances[s]) ||
+            (s < kClosestSamples && sampleDistances[s + 1] < sampleDistances[s])) {
+            continue;
+        }
+
+        double param = static_cast<double>(s) / kClosestSamples;
+        for (int step = 0; step < kMaxClosestSteps; ++step) {
+            QPointF offset = pointAt(param) - point;
+            QPointF d1 = derivativeAt(param);
+            QPointF d2 = secondDerivativeAt(param);
+            double g = QPointF::dotProduct(offset, d1);
+            double gPrime = QPointF::dotProduct(d1, d1) + QPointF::dotProduct(offset, d2);
+            if (gPrime <= 1e-12) {
+                break;  // Not converging towards a minimum
+            }
+            double next = qBound(0.0, param - g / gPrime, 1.0);
+            bool converged = std::abs(next - param) < 1e-9;
+            param = next;
+            if (converged) {
+                break;
+            }
+        }
+
+        // Newton can overshoot into a worse basin; keep the sample then
+        QPointF curvePoint = pointAt(param);
+        double d = vectorLength(point - curvePoint);
+        if (d > sampleDistances[s]) {
+            param = static_cast<double>(s) / kClosestSamples;
+            curvePoint = pointAt(param);
+            d = sampleDistances[s];
+        }
+        if (d < bestDistance) {
+            bestDistance = d;
+            bestT = param;
+            bestPoint = curvePoint;
+        }
+    }
+
+    if (t) *t = bestT;
+    if (distance) *distance = bestDistance;
+    return bestPoint;
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
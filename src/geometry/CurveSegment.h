@@ -0,0 +1,97 @@
+/**
+ * CurveSegment.h
+ *
+ * Evaluation of a single polyline segment (straight line or cubic Bezier)
+ */
+
+#ifndef PATTERNCAD_CURVESEGMENT_H
+#define PATTERNCAD_CURVESEGMENT_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * CurveSegment is a lightweight value type describing one edge of a polyline.
+ * It is either a straight line or a cubic Bezier and provides:
+ * - Point, derivative and unit tangent evaluation at parameter t (0-1)
+ * - Arc length using adaptive Gauss-Legendre quadrature
+ * - Inverse arc-length queries (parameter at a given length or fraction)
+ * - Closest point search (Newton refinement of a coarse sampling)
+ * - Adaptive flattening to line segments
+ *
+ * Length queries take an absolute tolerance in mm. When omitted, the
+ * application-wide default tolerance is used (see setDefaultTolerance).
+ * Flattening takes a chord-deviation tolerance in mm with its own default
+ * (see setDefaultFlatteningTolerance).
+ */
+class CurveSegment
+{
+public:
+    CurveSegment();
+    CurveSegment(const QPointF& start, const QPointF& end);
+    CurveSegment(const QPointF& start, const QPointF& control1,
+                 const QPointF& control2, const QPointF& end);
+
+    bool isCurve() const { return m_curve; }
+    QPointF start() const { return m_p0; }
+    QPointF control1() const { return m_c1; }
+    QPointF control2() const { return m_c2; }
+    QPointF end() const { return m_p1; }
+
+    // Evaluation
+    QPointF pointAt(double t) const;
+    QPointF derivativeAt(double t) const;
+    QPointF tangentAt(double t) const;  // Unit length, falls back to chord direction
+
+    // Exact bounds of the segment (end points and interior extrema), independent
+    // of any flattening tolerance
+    QRectF boundingRect() const;
+
+    // Arc length
+    double length(double tolerance = -1.0) const;
+    double lengthAt(double t, double tolerance = -1.0) const;  // Length of [0, t]
+    double parameterAtLength(double length, double tolerance = -1.0) const;
+    double parameterAtLength(double length, double totalLength, double tolerance) const;  // Total already known
+    double parameterAtFraction(double fraction, double tolerance = -1.0) const;
+    double fractionAtParameter(double t, double tolerance = -1.0) const;
+
+    // Closest point on the segment, optionally returning its parameter and
+    // its distance from the point
+    QPointF closestPoint(const QPointF& point, double* t = nullptr, double* distance = nullptr) const;
+
+    // Append points approximating the segment, excluding the start point and
+    // including the end point. Curves are subdivided until no chord deviates
+    // from the curve by more than the tolerance.
+    void flatten(QVector<QPointF>* points, double tolerance = -1.0) const;
+
+    // Default arc-length tolerance in mm (user preference)
+    static double defaultTolerance();
+    static void setDefaultTolerance(double tolerance);
+
+    // Default flattening tolerance in mm, used for on-screen geometry (user preference)
+    static double defaultFlatteningTolerance();
+    static void setDefaultFlatteningTolerance(double tolerance);
+
+private:
+    double integrate(double t0, double t1, double tolerance) const;
+    double integrateAdaptive(double t0, double t1, double whole,
+                             double tolerance, int depth) const;
+    double gaussLegendre(double t0, double t1) const;
+    double speedAt(double t) const;
+    QPointF secondDerivativeAt(double t) const;
+
+    QPointF m_p0;
+    QPointF m_c1;
+    QPointF m_c2;
+    QPointF m_p1;
+    bool m_curve;
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_CURVESEGMENT_H
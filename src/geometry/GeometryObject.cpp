@@ -6,6 +6,7 @@
 
 #include "GeometryObject.h"
 #include <QUuid>
+#include <QtMath>
 
 namespace PatternCAD {
 namespace Geometry {
@@ -74,10 +75,11 @@ bool GeometryObject::isSelected() const
 
 void GeometryObject::setSelected(bool selected)
 {
+    // Selecting is not an edit: no changed() notification, so the document
+    // is not marked modified (Document reports selection changes itself)
     if (m_selected != selected) {
         m_selected = selected;
         emit selectionChanged(selected);
-        notifyChanged();
     }
 }
 
@@ -156,6 +158,64 @@ QString GeometryObject::generateId() const
     return QUuid::createUuid().toString(QUuid::WithoutBraces);
 }
 
+void GeometryObject::drawAtScale(QPainter* painter, const QColor& color, double pixelsPerUnit) const
+{
+    Q_UNUSED(pixelsPerUnit);
+    draw(painter, color);
+}
+
+QTransform GeometryObject::rotationTransform(double angleDegrees, const QPointF& center)
+{
+    double angleRadians = qDegreesToRadians(angleDegrees);
+    double cosAngle = qCos(angleRadians);
+    double sinAngle = qSin(angleRadians);
+
+    // p' = center + R (p - center)
+    return QTransform(cosAngle, sinAngle,
+                      -sinAngle, cosAngle,
+                      center.x() - cosAngle * center.x() + sinAngle * center.y(),
+                      center.y() - sinAngle * center.x() - cosAngle * center.y());
+}
+
+QTransform GeometryObject::mirrorTransform(const QPointF& axisPoint1, const QPointF& axisPoint2)
+{
+    double dx = axisPoint2.x() - axisPoint1.x();
+    double dy = axisPoint2.y() - axisPoint1.y();
+
+    // Degenerate axis (two points are the same), no mirroring
+    double length = qSqrt(dx * dx + dy * dy);
+    if (length < 1e-10) {
+        return QTransform();
+    }
+    double ux = dx / length;
+    double uy = dy / length;
+
+    // p' = a + M (p - a) with the reflection M = 2 u u^T - I
+    double m11 = 2.0 * ux * ux - 1.0;
+    double m12 = 2.0 * ux * uy;
+    double m22 = 2.0 * uy * uy - 1.0;
+    return QTransform(m11, m12,
+                      m12, m22,
+                      axisPoint1.x() - m11 * axisPoint1.x() - m12 * axisPoint1.y(),
+                      axisPoint1.y() - m12 * axisPoint1.x() - m22 * axisPoint1.y());
+}
+
+QTransform GeometryObject::scaleTransform(double scaleX, double scaleY, const QPointF& origin)
+{
+    return QTransform(scaleX, 0.0,
+                      0.0, scaleY,
+                      origin.x() - scaleX * origin.x(),
+                      origin.y() - scaleY * origin.y());
+}
+
+QRectF GeometryObject::paintBounds() const
+{
+    // Half the pen width, plus the point markers drawn around selected objects
+    double penWidth = m_selected ? m_lineWeight + 1.0 : m_lineWeight;
+    double margin = penWidth / 2.0 + (m_selected ? 4.0 : 0.0);
+    return boundingRect().adjusted(-margin, -margin, margin, margin);
+}
+
 QPen GeometryObject::createPen(const QColor& layerColor) const
 {
     // Use lineColor if set, otherwise use layer color
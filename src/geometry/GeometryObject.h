@@ -11,6 +11,7 @@
 #include <QString>
 #include <QPointF>
 #include <QRectF>
+#include <QTransform>
 #include <QPainter>
 #include <QColor>
 #include <memory>
@@ -89,15 +90,37 @@ public:
 
     // Geometry
     virtual QRectF boundingRect() const = 0;
+    // Extent of everything draw() paints (pen, markers, decorations), used
+    // for culling and partial repaints
+    virtual QRectF paintBounds() const;
     virtual bool contains(const QPointF& point) const = 0;
+    // Farthest outside boundingRect() that contains() of any object type
+    // accepts a point (Point2D's pick radius)
+    static constexpr double MaxHitTolerance = 10.0;
     virtual void translate(const QPointF& delta) = 0;
     virtual void rotate(double angleDegrees, const QPointF& center) = 0;
     virtual void mirror(const QPointF& axisPoint1, const QPointF& axisPoint2) = 0;
     virtual void scale(double scaleX, double scaleY, const QPointF& origin) = 0;
 
+    // Apply the affine part of a matrix to the whole object in one pass.
+    // Directions (such as polyline tangents) follow the linear part and
+    // keep their length.
+    virtual void transform(const QTransform& matrix) = 0;
+
+    // Matrices equivalent to rotate(), mirror() and scale(), for applying
+    // one precomputed transform to many objects
+    static QTransform rotationTransform(double angleDegrees, const QPointF& center);
+    static QTransform mirrorTransform(const QPointF& axisPoint1, const QPointF& axisPoint2);
+    static QTransform scaleTransform(double scaleX, double scaleY, const QPointF& origin);
+
     // Drawing
     virtual void draw(QPainter* painter, const QColor& color = Qt::black) const = 0;
 
+    // Draw for a known device scale (pixels per scene unit), which may differ
+    // from the painter's own (e.g. when recording display lists). Objects with
+    // level-of-detail support use it to drop sub-pixel detail.
+    virtual void drawAtScale(QPainter* painter, const QColor& color, double pixelsPerUnit) const;
+
     // Serialization (to be implemented)
     // virtual QJsonObject toJson() const = 0;
     // virtual void fromJson(const QJsonObject& json) = 0;
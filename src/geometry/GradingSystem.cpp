@@ -189,17 +189,17 @@ Geometry::Polyline* GradingSystem::applyToSize(const Geometry::Polyline* base, i
     }
     
     // Apply grading rules to vertices
-    QVector<Geometry::PolylineVertex> vertices = graded->vertices();
-    
-    for (const GradeRule& rule : m_rules) {
-        if (rule.vertexIndex >= 0 && rule.vertexIndex < vertices.size()) {
-            // Apply offset: position += increment * offset
-            QPointF delta = rule.incrementPerSize * offset;
-            vertices[rule.vertexIndex].position += delta;
+    {
+        auto edit = graded->editVertices();
+        for (const GradeRule& rule : m_rules) {
+            if (rule.vertexIndex >= 0 && rule.vertexIndex < edit.size()) {
+                // Apply offset: position += increment * offset
+                QPointF delta = rule.incrementPerSize * offset;
+                edit.setPosition(rule.vertexIndex, edit.at(rule.vertexIndex).position + delta);
+            }
         }
     }
     
-    graded->setVertices(vertices);
     graded->setName(base->name() + " - " + m_sizes[sizeIndex].name);
     
     return graded;
@@ -239,6 +239,13 @@ void Line::scale(double scaleX, double scaleY, const QPointF& origin)
     notifyChanged();
 }
 
+void Line::transform(const QTransform& matrix)
+{
+    m_start = matrix.map(m_start);
+    m_end = matrix.map(m_end);
+    notifyChanged();
+}
+
 void Line::draw(QPainter* painter, const QColor& color) const
 {
     if (!m_visible) {
@@ -59,6 +59,7 @@ public:
     void rotate(double angleDegrees, const QPointF& center) override;
     void mirror(const QPointF& axisPoint1, const QPointF& axisPoint2) override;
     void scale(double scaleX, double scaleY, const QPointF& origin) override;
+    void transform(const QTransform& matrix) override;
 
     // Drawing
     void draw(QPainter* painter, const QColor& color = Qt::black) const override;
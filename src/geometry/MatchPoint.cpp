@@ -8,18 +8,12 @@
 #include "Polyline.h"
 #include <QUuid>
 #include <QFont>
+#include <QFontMetricsF>
 #include <QJsonArray>
 #include <algorithm>
 
 namespace PatternCAD {
 
-namespace {
-    // Calculate point on a line segment at parameter t (0-1)
-    QPointF pointOnSegment(const QPointF& p1, const QPointF& p2, double t) {
-        return p1 + (p2 - p1) * t;
-    }
-}
-
 MatchPoint::MatchPoint(QObject* parent)
     : QObject(parent)
     , m_label("A")
@@ -125,19 +119,12 @@ QPointF MatchPoint::calculateEdgePosition() const
         return m_absolutePosition;
     }
 
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    int n = vertices.size();
-    
-    if (n < 2 || m_segmentIndex < 0 || m_segmentIndex >= n) {
+    if (m_segmentIndex < 0 || m_segmentIndex >= m_polyline->segmentCount()) {
         return m_absolutePosition;
     }
 
-    int nextIdx = (m_segmentIndex + 1) % n;
-    
-    QPointF p1 = vertices[m_segmentIndex].position;
-    QPointF p2 = vertices[nextIdx].position;
-
-    return pointOnSegment(p1, p2, m_segmentPosition);
+    // m_segmentPosition is a fraction of the segment's arc length
+    return m_polyline->segmentPointAt(m_segmentIndex, m_segmentPosition);
 }
 
 void MatchPoint::linkTo(MatchPoint* other)
@@ -225,6 +212,24 @@ void MatchPoint::render(QPainter* painter, const QColor& color) const
     painter->restore();
 }
 
+QRectF MatchPoint::boundingRect() const
+{
+    // Same marker radius, label font and label offset as render()
+    const double radius = 4.0;
+    QPointF pos = position();
+    QRectF bounds(pos.x() - radius - 1.0, pos.y() - radius - 1.0,
+                  2.0 * radius + 2.0, 2.0 * radius + 2.0);
+
+    if (!m_label.isEmpty()) {
+        QFont font;
+        font.setBold(true);
+        font.setPointSize(9);
+        QRectF label = QFontMetricsF(font).boundingRect(m_label);
+        bounds |= label.translated(pos + QPointF(radius + 3, -radius - 2));
+    }
+    return bounds;
+}
+
 void MatchPoint::renderLinks(QPainter* painter, const QColor& color) const
 {
     if (m_linkedPoints.isEmpty()) {
@@ -69,6 +69,7 @@ public:
     // Rendering
     void render(QPainter* painter, const QColor& color = Qt::darkMagenta) const;
     void renderLinks(QPainter* painter, const QColor& color = Qt::darkGray) const;
+    QRectF boundingRect() const;  // Marker and label, without links
 
     // Clone for duplication
     MatchPoint* clone(Geometry::Polyline* newPolyline = nullptr) const;
@@ -92,7 +93,7 @@ private:
     bool m_isOnEdge;
     Geometry::Polyline* m_polyline;
     int m_segmentIndex;
-    double m_segmentPosition;  // 0.0-1.0 along segment
+    double m_segmentPosition;  // 0.0-1.0 arc-length fraction along segment
     
     // Linked match points
     QVector<MatchPoint*> m_linkedPoints;
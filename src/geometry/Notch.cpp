@@ -13,18 +13,6 @@
 namespace PatternCAD {
 
 namespace {
-    // Calculate point on a line segment at parameter t (0-1)
-    QPointF pointOnSegment(const QPointF& p1, const QPointF& p2, double t) {
-        return p1 + (p2 - p1) * t;
-    }
-
-    // Normalize a vector
-    QPointF normalize(const QPointF& v) {
-        double len = std::sqrt(v.x() * v.x() + v.y() * v.y());
-        if (len < 1e-10) return QPointF(1, 0);
-        return QPointF(v.x() / len, v.y() / len);
-    }
-
     // Get perpendicular vector (rotate 90 degrees CCW)
     QPointF perpendicular(const QPointF& v) {
         return QPointF(-v.y(), v.x());
@@ -111,69 +99,12 @@ QPointF Notch::getLocation() const
         return QPointF();
     }
 
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    int n = vertices.size();
-    
-    if (n < 2 || m_segmentIndex < 0 || m_segmentIndex >= n) {
+    if (m_segmentIndex < 0 || m_segmentIndex >= m_polyline->segmentCount()) {
         return QPointF();
     }
 
-    int nextIdx = (m_segmentIndex + 1) % n;
-    const Geometry::PolylineVertex& current = vertices[m_segmentIndex];
-    const Geometry::PolylineVertex& next = vertices[nextIdx];
-    
-    // Check if segment is curved
-    bool needsCurve = (current.type == Geometry::VertexType::Smooth) ||
-                      (next.type == Geometry::VertexType::Smooth);
-    
-    QPointF p1 = current.position;
-    QPointF p2 = next.position;
-    
-    if (!needsCurve) {
-        // Linear segment
-        return pointOnSegment(p1, p2, m_position);
-    }
-    
-    // Curved segment - evaluate Bezier
-    QPointF segment = p2 - p1;
-    double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-    double controlDistance = dist / 3.0;
-    
-    QPointF c1, c2;
-    
-    // Control point c1 (outgoing from current)
-    if (current.type == Geometry::VertexType::Smooth && current.tangent != QPointF()) {
-        c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-    } else if (current.type == Geometry::VertexType::Smooth) {
-        int prevIdx = (m_segmentIndex - 1 + n) % n;
-        QPointF p0 = vertices[prevIdx].position;
-        if (!m_polyline->isClosed() && m_segmentIndex == 0) p0 = p1;
-        c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-    } else {
-        c1 = p1 + segment * 0.01;
-    }
-    
-    // Control point c2 (incoming to next)
-    if (next.type == Geometry::VertexType::Smooth && next.tangent != QPointF()) {
-        c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-    } else if (next.type == Geometry::VertexType::Smooth) {
-        int nextNextIdx = (m_segmentIndex + 2) % n;
-        QPointF p3 = vertices[nextNextIdx].position;
-        if (!m_polyline->isClosed() && nextIdx == n - 1) p3 = p2;
-        c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-    } else {
-        c2 = p2 - segment * 0.01;
-    }
-    
-    // Evaluate cubic Bezier at t = m_position
-    double t = m_position;
-    double u = 1.0 - t;
-    double tt = t * t;
-    double uu = u * u;
-    double uuu = uu * u;
-    double ttt = tt * t;
-    
-    return uuu * p1 + 3.0 * uu * t * c1 + 3.0 * u * tt * c2 + ttt * p2;
+    // m_position is a fraction of the segment's arc length
+    return m_polyline->segmentPointAt(m_segmentIndex, m_position);
 }
 
 QPointF Notch::getNormal() const
@@ -182,72 +113,14 @@ QPointF Notch::getNormal() const
         return QPointF(0, -1);  // Default upward
     }
 
-    QVector<Geometry::PolylineVertex> vertices = m_polyline->vertices();
-    int n = vertices.size();
-    
-    if (n < 2 || m_segmentIndex < 0 || m_segmentIndex >= n) {
+    if (m_segmentIndex < 0 || m_segmentIndex >= m_polyline->segmentCount()) {
         return QPointF(0, -1);
     }
 
-    int nextIdx = (m_segmentIndex + 1) % n;
-    const Geometry::PolylineVertex& current = vertices[m_segmentIndex];
-    const Geometry::PolylineVertex& next = vertices[nextIdx];
-    
-    QPointF p1 = current.position;
-    QPointF p2 = next.position;
-    
-    // Check if segment is curved
-    bool needsCurve = (current.type == Geometry::VertexType::Smooth) ||
-                      (next.type == Geometry::VertexType::Smooth);
-    
-    QPointF tangent;
-    
-    if (!needsCurve) {
-        // Linear segment - tangent is just the segment direction
-        tangent = p2 - p1;
-    } else {
-        // Curved segment - calculate tangent from Bezier derivative
-        QPointF segment = p2 - p1;
-        double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-        double controlDistance = dist / 3.0;
-        
-        QPointF c1, c2;
-        
-        if (current.type == Geometry::VertexType::Smooth && current.tangent != QPointF()) {
-            c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-        } else if (current.type == Geometry::VertexType::Smooth) {
-            int prevIdx = (m_segmentIndex - 1 + n) % n;
-            QPointF p0 = vertices[prevIdx].position;
-            if (!m_polyline->isClosed() && m_segmentIndex == 0) p0 = p1;
-            c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-        } else {
-            c1 = p1 + segment * 0.01;
-        }
-        
-        if (next.type == Geometry::VertexType::Smooth && next.tangent != QPointF()) {
-            c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-        } else if (next.type == Geometry::VertexType::Smooth) {
-            int nextNextIdx = (m_segmentIndex + 2) % n;
-            QPointF p3 = vertices[nextNextIdx].position;
-            if (!m_polyline->isClosed() && nextIdx == n - 1) p3 = p2;
-            c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-        } else {
-            c2 = p2 - segment * 0.01;
-        }
-        
-        // Bezier derivative at t: B'(t) = 3(1-t)²(c1-p1) + 6(1-t)t(c2-c1) + 3t²(p2-c2)
-        double t = m_position;
-        double u = 1.0 - t;
-        tangent = 3.0 * u * u * (c1 - p1) + 6.0 * u * t * (c2 - c1) + 3.0 * t * t * (p2 - c2);
-    }
-    
-    // Normalize and get perpendicular
-    QPointF edgeDir = normalize(tangent);
-    
+    QPointF edgeDir = m_polyline->segmentTangentAt(m_segmentIndex, m_position);
+
     // Normal is perpendicular to edge, pointing outward (left side for CCW)
-    QPointF normal = perpendicular(edgeDir);
-    
-    return normal;
+    return perpendicular(edgeDir);
 }
 
 void Notch::render(QPainter* painter, const QColor& color) const
@@ -281,6 +154,19 @@ void Notch::render(QPainter* painter, const QColor& color) const
     painter->restore();
 }
 
+QRectF Notch::boundingRect() const
+{
+    if (!m_polyline) {
+        return QRectF();
+    }
+
+    // Every style stays within the depth (or the minimum dot radius) of the
+    // location, plus the pen
+    double reach = qMax(m_depth, 1.5) + 1.0;
+    QPointF loc = getLocation();
+    return QRectF(loc.x() - reach, loc.y() - reach, 2.0 * reach, 2.0 * reach);
+}
+
 void Notch::renderVNotch(QPainter* painter, const QPointF& loc, const QPointF& normal) const
 {
     // V-notch: Two lines forming a V shape pointing inward
@@ -50,7 +50,7 @@ public:
     Geometry::Polyline* polyline() const { return m_polyline; }
     void setPolyline(Geometry::Polyline* polyline);
 
-    // Position on segment (0.0 - 1.0)
+    // Position on segment (0.0 - 1.0, fraction of the segment's arc length)
     int segmentIndex() const { return m_segmentIndex; }
     void setSegmentIndex(int index);
 
@@ -71,6 +71,7 @@ public:
 
     // Rendering
     void render(QPainter* painter, const QColor& color = Qt::darkBlue) const;
+    QRectF boundingRect() const;
 
     // Clone for duplication
     Notch* clone(Geometry::Polyline* newPolyline = nullptr) const;
@@ -86,7 +87,7 @@ private:
     QString m_id;
     Geometry::Polyline* m_polyline;
     int m_segmentIndex;      // Index of the segment (edge) this notch is on
-    double m_position;       // Position along segment (0.0 = start, 1.0 = end)
+    double m_position;       // Arc-length fraction along segment (0.0 = start, 1.0 = end)
     NotchStyle m_style;
     double m_depth;          // Depth in mm
 
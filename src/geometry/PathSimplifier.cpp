@@ -0,0 +1,119 @@
+/**
+ * PathSimplifier.cpp
+ *
+ * Implementation of PathSimplifier
+ */
+
+#include "PathSimplifier.h"
+#include <QPair>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+namespace {
+    // Squared distance from p to the segment a-b
+    double segmentDistanceSquared(const QPointF& p, const QPointF& a, const QPointF& b)
+    {
+        QPointF ab = b - a;
+        QPointF ap = p - a;
+        double lengthSquared = ab.x() * ab.x() + ab.y() * ab.y();
+        double t = 0.0;
+        if (lengthSquared > 0.0) {
+            t = qBound(0.0, (ap.x() * ab.x() + ap.y() * ab.y()) / lengthSquared, 1.0);
+        }
+        QPointF d = ap - ab * t;
+        return d.x() * d.x() + d.y() * d.y();
+    }
+}
+
+QPolygonF PathSimplifier::simplify(const QPolygonF& points, double tolerance)
+{
+    int n = points.size();
+    if (n <= 2 || tolerance <= 0.0) {
+        return points;
+    }
+
+    QVector<bool> keep(n, false);
+    keep[0] = true;
+    keep[n - 1] = true;
+    markKept(points, 0, n - 1, tolerance * tolerance, &keep);
+
+    QPolygonF result;
+    for (int i = 0; i < n; ++i) {
+        if (keep[i]) {
+            result.append(points[i]);
+        }
+    }
+    return result;
+}
+
+QPolygonF PathSimplifier::simplifyClosed(const QPolygonF& points, double tolerance)
+{
+    int n = points.size();
+    if (n <= 3 || tolerance <= 0.0) {
+        return points;
+    }
+
+    // Split the loop at the first point and the point farthest from it, and
+    // simplify both halves as open polylines
+    int split = 0;
+    double maxDistance = -1.0;
+    for (int i = 1; i < n; ++i) {
+        QPointF d = points[i] - points[0];
+        double distance = d.x() * d.x() + d.y() * d.y();
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            split = i;
+        }
+    }
+
+    QPolygonF loop = points;
+    loop.append(points[0]);
+
+    QVector<bool> keep(n + 1, false);
+    keep[0] = true;
+    keep[split] = true;
+    keep[n] = true;
+    double toleranceSquared = tolerance * tolerance;
+    markKept(loop, 0, split, toleranceSquared, &keep);
+    markKept(loop, split, n, toleranceSquared, &keep);
+
+    QPolygonF result;
+    for (int i = 0; i < n; ++i) {
+        if (keep[i]) {
+            result.append(points[i]);
+        }
+    }
+    return result;
+}
+
+void PathSimplifier::markKept(const QPolygonF& points, int first, int last,
+                              double toleranceSquared, QVector<bool>* keep)
+{
+    // Iterative to stay safe on outlines with many thousands of points
+    QVector<QPair<int, int>> stack;
+    stack.append(qMakePair(first, last));
+
+    while (!stack.isEmpty()) {
+        QPair<int, int> range = stack.takeLast();
+        int farthest = -1;
+        double maxDistance = toleranceSquared;
+        for (int i = range.first + 1; i < range.second; ++i) {
+            double distance = segmentDistanceSquared(points[i], points[range.first], points[range.second]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = i;
+            }
+        }
+
+        if (farthest >= 0) {
+            (*keep)[farthest] = true;
+            stack.append(qMakePair(range.first, farthest));
+            stack.append(qMakePair(farthest, range.second));
+        }
+    }
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
@@ -0,0 +1,39 @@
+/**
+ * PathSimplifier.h
+ *
+ * Point reduction for flattened outlines
+ */
+
+#ifndef PATTERNCAD_PATHSIMPLIFIER_H
+#define PATTERNCAD_PATHSIMPLIFIER_H
+
+#include <QPolygonF>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * PathSimplifier reduces the point count of flattened outlines with the
+ * Douglas-Peucker algorithm: kept points form a polyline that deviates from
+ * the original by at most the tolerance. End points (and for closed
+ * outlines, the two points farthest apart) are always kept.
+ */
+class PathSimplifier
+{
+public:
+    // Open polyline from points.first() to points.last()
+    static QPolygonF simplify(const QPolygonF& points, double tolerance);
+
+    // Closed outline, given without a closing duplicate point
+    static QPolygonF simplifyClosed(const QPolygonF& points, double tolerance);
+
+private:
+    static void markKept(const QPolygonF& points, int first, int last,
+                         double toleranceSquared, QVector<bool>* keep);
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_PATHSIMPLIFIER_H
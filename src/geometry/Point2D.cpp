@@ -188,6 +188,11 @@ void Point2D::scale(double scaleX, double scaleY, const QPointF& origin)
     setPosition(origin.x() + scaledX, origin.y() + scaledY);
 }
 
+void Point2D::transform(const QTransform& matrix)
+{
+    setPosition(matrix.map(m_position));
+}
+
 void Point2D::draw(QPainter* painter, const QColor& color) const
 {
     if (!m_visible) {
@@ -0,0 +1,124 @@
+/**
+ * PolygonContainment.cpp
+ *
+ * Implementation of PolygonContainment
+ */
+
+#include "PolygonContainment.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PatternCAD {
+namespace Geometry {
+
+namespace {
+    // Average edges per slab the slab count aims for, and its cap
+    const int kEdgesPerSlab = 4;
+    const int kMaxSlabs = 4096;
+}
+
+PolygonContainment::PolygonContainment()
+    : m_slabHeight(0.0)
+{
+}
+
+void PolygonContainment::clear()
+{
+    m_edges.clear();
+    m_bounds = QRectF();
+    m_slabHeight = 0.0;
+    m_slabStart.clear();
+    m_slabEdges.clear();
+}
+
+void PolygonContainment::build(const QPolygonF& outline)
+{
+    clear();
+    int n = outline.size();
+    if (n < 3) {
+        return;
+    }
+
+    // Horizontal edges never cross a horizontal ray under the half-open
+    // rule below, so they are left out
+    m_edges.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const QPointF& a = outline[i];
+        const QPointF& b = outline[(i + 1 == n) ? 0 : i + 1];
+        if (a.y() < b.y()) {
+            m_edges.append(Edge{a.x(), a.y(), b.x(), b.y(), +1});
+        } else if (a.y() > b.y()) {
+            m_edges.append(Edge{b.x(), b.y(), a.x(), a.y(), -1});
+        }
+    }
+    if (m_edges.isEmpty()) {
+        return;
+    }
+    m_bounds = outline.boundingRect();
+
+    int slabCount = std::clamp(static_cast<int>(m_edges.size()) / kEdgesPerSlab, 1, kMaxSlabs);
+    m_slabHeight = m_bounds.height() / slabCount;
+
+    // Counting pass, then fill, giving one flat array for all slabs
+    m_slabStart.fill(0, slabCount + 1);
+    for (const Edge& edge : m_edges) {
+        for (int s = slabOf(edge.y0), last = slabOf(edge.y1); s <= last; ++s) {
+            ++m_slabStart[s + 1];
+        }
+    }
+    for (int s = 0; s < slabCount; ++s) {
+        m_slabStart[s + 1] += m_slabStart[s];
+    }
+
+    m_slabEdges.resize(m_slabStart[slabCount]);
+    QVector<int> fill = m_slabStart;
+    for (int e = 0; e < m_edges.size(); ++e) {
+        for (int s = slabOf(m_edges[e].y0), last = slabOf(m_edges[e].y1); s <= last; ++s) {
+            m_slabEdges[fill[s]++] = e;
+        }
+    }
+}
+
+int PolygonContainment::slabOf(double y) const
+{
+    int slabCount = m_slabStart.size() - 1;
+    if (m_slabHeight <= 0.0) {
+        return 0;
+    }
+    int slab = static_cast<int>(std::floor((y - m_bounds.top()) / m_slabHeight));
+    return std::clamp(slab, 0, slabCount - 1);
+}
+
+int PolygonContainment::windingNumber(const QPointF& point) const
+{
+    if (m_edges.isEmpty() || !m_bounds.contains(point)) {
+        return 0;
+    }
+
+    // Count crossings of the ray from the point towards +x. Edges own their
+    // lower end point only, so a ray through a vertex is counted once.
+    const double px = point.x();
+    const double py = point.y();
+    int slab = slabOf(py);
+    int winding = 0;
+    for (int i = m_slabStart[slab], end = m_slabStart[slab + 1]; i < end; ++i) {
+        const Edge& edge = m_edges[m_slabEdges[i]];
+        if (py < edge.y0 || py >= edge.y1) {
+            continue;
+        }
+        double x = edge.x0 + (py - edge.y0) * (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+        if (x > px) {
+            winding += edge.direction;
+        }
+    }
+    return winding;
+}
+
+bool PolygonContainment::contains(const QPointF& point, Qt::FillRule fillRule) const
+{
+    int winding = windingNumber(point);
+    return (fillRule == Qt::WindingFill) ? winding != 0 : (winding % 2) != 0;
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
@@ -0,0 +1,65 @@
+/**
+ * PolygonContainment.h
+ *
+ * Slab-indexed point-in-polygon test for flattened outlines
+ */
+
+#ifndef PATTERNCAD_POLYGONCONTAINMENT_H
+#define PATTERNCAD_POLYGONCONTAINMENT_H
+
+#include <QPolygonF>
+#include <QRectF>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * PolygonContainment answers point-in-polygon queries for a closed outline
+ * without walking the whole edge list:
+ * - Points outside the bounding box are rejected immediately
+ * - The y range is cut into horizontal slabs, each listing the edges that
+ *   overlap it, so a query only tests the edges of one slab
+ * - The winding number of a rightward ray decides containment, under
+ *   either fill rule
+ * build() is O(n + entries), where each edge is listed in every slab it
+ * spans; queries are O(edges in the slab).
+ */
+class PolygonContainment
+{
+public:
+    PolygonContainment();
+
+    void clear();
+
+    // Closed outline, given without a closing duplicate point
+    void build(const QPolygonF& outline);
+
+    bool isEmpty() const { return m_edges.isEmpty(); }
+    QRectF bounds() const { return m_bounds; }
+
+    // Signed number of times the outline winds around the point
+    int windingNumber(const QPointF& point) const;
+
+    bool contains(const QPointF& point, Qt::FillRule fillRule = Qt::OddEvenFill) const;
+
+private:
+    // Non-horizontal edge, stored bottom-up (y0 < y1)
+    struct Edge {
+        double x0, y0, x1, y1;
+        int direction;  // +1 if the outline runs upwards along the edge
+    };
+
+    int slabOf(double y) const;
+
+    QVector<Edge> m_edges;
+    QRectF m_bounds;
+    double m_slabHeight;
+    QVector<int> m_slabStart;  // Slab s lists m_slabEdges[m_slabStart[s] .. m_slabStart[s + 1])
+    QVector<int> m_slabEdges;
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_POLYGONCONTAINMENT_H
@@ -9,9 +9,11 @@
 #include "Notch.h"
 #include "MatchPoint.h"
 #include "GradingSystem.h"
+#include "PathSimplifier.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QtMath>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -19,87 +21,97 @@ namespace PatternCAD {
 namespace Geometry {
 
 namespace {
-    // Helper function to rotate a point around a center
-    QPointF rotatePoint(const QPointF& point, double angleDegrees, const QPointF& center) {
-        double angleRadians = qDegreesToRadians(angleDegrees);
-        double cosAngle = qCos(angleRadians);
-        double sinAngle = qSin(angleRadians);
-
-        double dx = point.x() - center.x();
-        double dy = point.y() - center.y();
-
-        double rotatedX = dx * cosAngle - dy * sinAngle;
-        double rotatedY = dx * sinAngle + dy * cosAngle;
-
-        return QPointF(center.x() + rotatedX, center.y() + rotatedY);
-    }
-
-    // Helper to rotate a vector (for tangent rotation, no translation)
-    QPointF rotateVector(const QPointF& vec, double angleDegrees) {
-        double angleRadians = qDegreesToRadians(angleDegrees);
-        double cosAngle = qCos(angleRadians);
-        double sinAngle = qSin(angleRadians);
-
-        double rotatedX = vec.x() * cosAngle - vec.y() * sinAngle;
-        double rotatedY = vec.x() * sinAngle + vec.y() * cosAngle;
-
-        return QPointF(rotatedX, rotatedY);
-    }
-
-    // Helper function to mirror a point across an axis
-    QPointF mirrorPoint(const QPointF& point, const QPointF& axisPoint1, const QPointF& axisPoint2) {
-        double dx = axisPoint2.x() - axisPoint1.x();
-        double dy = axisPoint2.y() - axisPoint1.y();
+    // Build segment i -> i+1 of a polyline. Positions can be overridden for one
+    // vertex (used to evaluate a drag before it is committed).
+    CurveSegment buildSegment(const VertexStore& vertices, bool closed, int i,
+                              int overrideIndex = -1, const QPointF& overridePosition = QPointF())
+    {
+        int n = vertices.size();
+        auto positionOf = [&](int idx) -> QPointF {
+            return idx == overrideIndex ? overridePosition : vertices.position(idx);
+        };
 
-        double length = qSqrt(dx * dx + dy * dy);
-        if (length < 1e-10) {
-            return point;
+        int nextIdx = (i + 1) % n;
+        QPointF p1 = positionOf(i);
+        QPointF p2 = positionOf(nextIdx);
+
+        // A segment is curved if EITHER endpoint is smooth; straight segments
+        // never touch the curve arrays
+        bool needsCurve = vertices.isSmooth(i) || vertices.isSmooth(nextIdx);
+        if (!needsCurve) {
+            return CurveSegment(p1, p2);
         }
-        double ux = dx / length;
-        double uy = dy / length;
 
-        double vx = point.x() - axisPoint1.x();
-        double vy = point.y() - axisPoint1.y();
-
-        double projection = vx * ux + vy * uy;
+        PolylineVertex current = vertices.at(i);
+        PolylineVertex next = vertices.at(nextIdx);
+
+        // Distance between points for scaling control points
+        QPointF segment = p2 - p1;
+        double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
+        double controlDistance = dist / 3.0;
+
+        QPointF c1, c2;
+
+        // Determine control point c1 (outgoing from current)
+        if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
+            // Current is smooth with explicit tangent
+            c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
+        } else if (current.type == VertexType::Smooth) {
+            // Current is smooth: use Catmull-Rom
+            QPointF p0 = positionOf((i - 1 + n) % n);
+            if (!closed && i == 0) p0 = p1;
+            c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
+        } else {
+            // Current is sharp: place control point very close to p1 for sharp angle
+            c1 = p1 + (p2 - p1) * 0.01;
+        }
 
-        double closestX = axisPoint1.x() + projection * ux;
-        double closestY = axisPoint1.y() + projection * uy;
+        // Determine control point c2 (incoming to next)
+        if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
+            // Next is smooth with explicit tangent - symmetric control
+            c2 = p2 - next.tangent * controlDistance * next.incomingTension;
+        } else if (next.type == VertexType::Smooth) {
+            // Next is smooth: use Catmull-Rom
+            QPointF p3 = positionOf((i + 2) % n);
+            if (!closed && nextIdx == n - 1) p3 = p2;
+            c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
+        } else {
+            // Next is sharp: place control point very close to p2 for sharp angle
+            c2 = p2 - (p2 - p1) * 0.01;
+        }
 
-        return QPointF(2.0 * closestX - point.x(), 2.0 * closestY - point.y());
+        return CurveSegment(p1, c1, c2, p2);
     }
 
-    // Helper to mirror a vector (for tangent mirroring, no translation)
-    QPointF mirrorVector(const QPointF& vec, const QPointF& axisPoint1, const QPointF& axisPoint2) {
-        double dx = axisPoint2.x() - axisPoint1.x();
-        double dy = axisPoint2.y() - axisPoint1.y();
-
-        double length = qSqrt(dx * dx + dy * dy);
-        if (length < 1e-10) {
-            return vec;
+    // Bounds of a segment's control polygon, which contains the curve
+    QRectF controlBounds(const CurveSegment& segment)
+    {
+        QPointF p0 = segment.start();
+        QPointF p1 = segment.end();
+        double minX = std::min(p0.x(), p1.x());
+        double minY = std::min(p0.y(), p1.y());
+        double maxX = std::max(p0.x(), p1.x());
+        double maxY = std::max(p0.y(), p1.y());
+        if (segment.isCurve()) {
+            for (const QPointF& c : {segment.control1(), segment.control2()}) {
+                minX = std::min(minX, c.x());
+                minY = std::min(minY, c.y());
+                maxX = std::max(maxX, c.x());
+                maxY = std::max(maxY, c.y());
+            }
         }
-        double ux = dx / length;
-        double uy = dy / length;
-
-        // Project vector onto axis
-        double projection = vec.x() * ux + vec.y() * uy;
-
-        // Mirror the vector
-        double mirroredX = 2.0 * projection * ux - vec.x();
-        double mirroredY = 2.0 * projection * uy - vec.y();
-
-        return QPointF(mirroredX, mirroredY);
+        return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
     }
 
-    // Helper function to scale a point around an origin
-    QPointF scalePoint(const QPointF& point, double scaleX, double scaleY, const QPointF& origin) {
-        double dx = point.x() - origin.x();
-        double dy = point.y() - origin.y();
-
-        double scaledX = dx * scaleX;
-        double scaledY = dy * scaleY;
+    // Index entries carry their vertex/segment/handle key as user data
+    void* keyToUserData(int key)
+    {
+        return reinterpret_cast<void*>(static_cast<quintptr>(key));
+    }
 
-        return QPointF(origin.x() + scaledX, origin.y() + scaledY);
+    int userDataToKey(void* userData)
+    {
+        return static_cast<int>(reinterpret_cast<quintptr>(userData));
     }
 }
 
@@ -108,6 +120,14 @@ Polyline::Polyline(QObject* parent)
     , m_closed(true)
     , m_seamAllowance(new SeamAllowance(this))
     , m_gradingSystem(nullptr)
+    , m_revision(1)
+    , m_cacheRevision(0)
+    , m_cachedOutlineTolerance(0.0)
+    , m_containmentValid(false)
+    , m_selfIntersectionsValid(false)
+    , m_structuralRevision(1)
+    , m_arcLengthsValid(false)
+    , m_pickIndexRevision(0)
 {
     m_seamAllowance->setSourcePolyline(this);
     connect(m_seamAllowance, &SeamAllowance::changed, this, [this]() { notifyChanged(); });
@@ -119,6 +139,14 @@ Polyline::Polyline(const QVector<PolylineVertex>& vertices, QObject* parent)
     , m_closed(true)
     , m_seamAllowance(new SeamAllowance(this))
     , m_gradingSystem(nullptr)
+    , m_revision(1)
+    , m_cacheRevision(0)
+    , m_cachedOutlineTolerance(0.0)
+    , m_containmentValid(false)
+    , m_selfIntersectionsValid(false)
+    , m_structuralRevision(1)
+    , m_arcLengthsValid(false)
+    , m_pickIndexRevision(0)
 {
     m_seamAllowance->setSourcePolyline(this);
     connect(m_seamAllowance, &SeamAllowance::changed, this, [this]() { notifyChanged(); });
@@ -129,103 +157,183 @@ Polyline::~Polyline()
 }
 
 void Polyline::setVertices(const QVector<PolylineVertex>& vertices)
+{
+    m_vertices.assign(vertices);
+    geometryChanged();
+}
+
+void Polyline::setVertices(const VertexStore& vertices)
 {
     m_vertices = vertices;
-    notifyChanged();
+    geometryChanged();
 }
 
 void Polyline::addVertex(const QPointF& position, VertexType type, double tension, const QPointF& tangent)
 {
     m_vertices.append(PolylineVertex(position, type, tension, tangent));
-    notifyChanged();
+    geometryChanged();
 }
 
 void Polyline::addVertex(const PolylineVertex& vertex)
 {
     m_vertices.append(vertex);
-    notifyChanged();
+    geometryChanged();
 }
 
 void Polyline::setClosed(bool closed)
 {
     if (m_closed != closed) {
         m_closed = closed;
-        notifyChanged();
+        geometryChanged();
     }
 }
 
 QRectF Polyline::boundingRect() const
 {
-    if (m_vertices.isEmpty()) {
-        return QRectF();
-    }
+    ensureGeometryCache();
+    return m_cachedBounds;
+}
 
-    qreal minX = m_vertices[0].position.x();
-    qreal minY = m_vertices[0].position.y();
-    qreal maxX = minX;
-    qreal maxY = minY;
+QRectF Polyline::paintBounds() const
+{
+    QRectF bounds = GeometryObject::paintBounds();
 
-    for (const auto& vertex : m_vertices) {
-        minX = qMin(minX, vertex.position.x());
-        minY = qMin(minY, vertex.position.y());
-        maxX = qMax(maxX, vertex.position.x());
-        maxY = qMax(maxY, vertex.position.y());
+    if (m_seamAllowance && m_seamAllowance->isEnabled()) {
+        bounds |= m_seamAllowance->boundingRect();
     }
+    for (const Notch* notch : m_notches) {
+        bounds |= notch->boundingRect();
+    }
+    for (const MatchPoint* mp : m_matchPoints) {
+        bounds |= mp->boundingRect();
 
-    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+        // Links to other pieces are drawn while selected
+        if (m_selected) {
+            for (const MatchPoint* other : mp->linkedPoints()) {
+                bounds |= QRectF(mp->position(), other->position()).normalized();
+            }
+        }
+    }
+    return bounds;
 }
 
 bool Polyline::contains(const QPointF& point) const
 {
-    QPainterPath path = createPath();
-    return path.contains(point);
+    // Same odd-even rule as the path, tested against the flattened outline
+    ensureGeometryCache();
+    if (!m_containmentValid) {
+        m_containment.build(m_cachedOutline);
+        m_containmentValid = true;
+    }
+    return m_containment.contains(point);
 }
 
 void Polyline::translate(const QPointF& delta)
 {
-    for (auto& vertex : m_vertices) {
-        vertex.position += delta;
-    }
-    notifyChanged();
+    m_vertices.translate(delta.x(), delta.y());
+    geometryChanged();
 }
 
 void Polyline::rotate(double angleDegrees, const QPointF& center)
 {
-    for (auto& vertex : m_vertices) {
-        // Rotate the position
-        vertex.position = rotatePoint(vertex.position, angleDegrees, center);
-        // Rotate the tangent vector (if it exists)
-        if (vertex.tangent != QPointF()) {
-            vertex.tangent = rotateVector(vertex.tangent, angleDegrees);
-        }
-    }
-    notifyChanged();
+    transform(rotationTransform(angleDegrees, center));
 }
 
 void Polyline::mirror(const QPointF& axisPoint1, const QPointF& axisPoint2)
 {
-    for (auto& vertex : m_vertices) {
-        // Mirror the position
-        vertex.position = mirrorPoint(vertex.position, axisPoint1, axisPoint2);
-        // Mirror the tangent vector (if it exists)
-        if (vertex.tangent != QPointF()) {
-            vertex.tangent = mirrorVector(vertex.tangent, axisPoint1, axisPoint2);
-        }
-    }
-    notifyChanged();
+    transform(mirrorTransform(axisPoint1, axisPoint2));
 }
 
 void Polyline::scale(double scaleX, double scaleY, const QPointF& origin)
 {
-    for (auto& vertex : m_vertices) {
-        // Scale the position
-        vertex.position = scalePoint(vertex.position, scaleX, scaleY, origin);
-        // Tangent vectors remain unchanged (they are directions, not positions)
+    transform(scaleTransform(scaleX, scaleY, origin));
+}
+
+void Polyline::transform(const QTransform& matrix)
+{
+    m_vertices.transform(matrix);
+    geometryChanged();
+}
+
+int Polyline::lodLevelCount()
+{
+    return 5;
+}
+
+double Polyline::lodTolerance(int level)
+{
+    // 0.5 mm, then four times coarser per level
+    return level <= 0 ? 0.0 : 0.5 * std::pow(4.0, level - 1);
+}
+
+int Polyline::lodLevelForScale(double pixelsPerUnit)
+{
+    if (pixelsPerUnit <= 0.0) {
+        return 0;
     }
-    notifyChanged();
+
+    double halfPixel = 0.5 / pixelsPerUnit;
+    int level = 0;
+    while (level + 1 < lodLevelCount() && lodTolerance(level + 1) <= halfPixel) {
+        ++level;
+    }
+    return level;
+}
+
+const QPolygonF& Polyline::lodOutline(int level) const
+{
+    ensureGeometryCache();
+    level = qBound(0, level, lodLevelCount() - 1);
+    if (level == 0) {
+        return m_cachedOutline;
+    }
+
+    if (m_lodOutlines.size() < lodLevelCount()) {
+        m_lodOutlines.resize(lodLevelCount());
+    }
+    QPolygonF& outline = m_lodOutlines[level];
+    if (outline.isEmpty() && !m_cachedOutline.isEmpty()) {
+        outline = m_closed ? PathSimplifier::simplifyClosed(m_cachedOutline, lodTolerance(level))
+                           : PathSimplifier::simplify(m_cachedOutline, lodTolerance(level));
+    }
+    return outline;
+}
+
+const QVector<Polyline::SegmentIntersection>& Polyline::selfIntersections() const
+{
+    ensureGeometryCache();
+    if (m_selfIntersectionsValid) {
+        return m_selfIntersections;
+    }
+
+    // Outline edge e runs from point e to e + 1; it belongs to the first
+    // segment whose flattening had appended point e + 1
+    auto segmentOfEdge = [this](int edge) {
+        if (m_outlineSegmentEnds.isEmpty()) {
+            return edge;
+        }
+        auto it = std::lower_bound(m_outlineSegmentEnds.constBegin(), m_outlineSegmentEnds.constEnd(), edge + 2);
+        int segment = static_cast<int>(it - m_outlineSegmentEnds.constBegin());
+        return std::min(segment, static_cast<int>(m_outlineSegmentEnds.size()) - 1);
+    };
+
+    m_selfIntersections.clear();
+    for (const EdgeIntersection& hit : SelfIntersectionFinder::find(m_cachedOutline, m_closed)) {
+        m_selfIntersections.append({segmentOfEdge(hit.firstEdge), segmentOfEdge(hit.secondEdge),
+                                    hit.point, hit.overlap});
+    }
+    m_selfIntersectionsValid = true;
+    return m_selfIntersections;
 }
 
 void Polyline::draw(QPainter* painter, const QColor& color) const
+{
+    // Scale taken from the painter (device pixels per scene unit)
+    const QTransform& transform = painter->worldTransform();
+    drawAtScale(painter, color, std::sqrt(std::abs(transform.determinant())));
+}
+
+void Polyline::drawAtScale(QPainter* painter, const QColor& color, double pixelsPerUnit) const
 {
     if (m_vertices.size() < 2) {
         return;
@@ -239,17 +347,28 @@ void Polyline::draw(QPainter* painter, const QColor& color) const
     painter->setPen(pen);
     painter->setBrush(Qt::NoBrush);
 
-    // Draw the path
-    QPainterPath path = createPath();
-    painter->drawPath(path);
+    // Draw the path, simplified when zoomed out far enough
+    int lodLevel = lodLevelForScale(pixelsPerUnit);
+    if (lodLevel == 0) {
+        painter->drawPath(path());
+    } else if (m_closed) {
+        painter->drawPolygon(lodOutline(lodLevel));
+    } else {
+        painter->drawPolyline(lodOutline(lodLevel));
+    }
+
+    // Markers smaller than a device pixel are skipped
+    auto visibleAtScale = [pixelsPerUnit](double size) {
+        return pixelsPerUnit <= 0.0 || size * pixelsPerUnit >= 1.0;
+    };
 
     // Draw vertex markers if selected
-    if (m_selected) {
-        for (const auto& vertex : m_vertices) {
-            QColor vertexColor = (vertex.type == VertexType::Sharp) ? Qt::red : Qt::green;
+    if (m_selected && visibleAtScale(6.0)) {
+        for (int i = 0; i < m_vertices.size(); ++i) {
+            QColor vertexColor = m_vertices.isSmooth(i) ? Qt::green : Qt::red;
             painter->setBrush(vertexColor);
             painter->setPen(Qt::NoPen);
-            painter->drawEllipse(vertex.position, 3, 3);
+            painter->drawEllipse(m_vertices.position(i), 3, 3);
         }
     }
 
@@ -260,12 +379,16 @@ void Polyline::draw(QPainter* painter, const QColor& color) const
 
     // Draw notches
     for (const Notch* notch : m_notches) {
-        notch->render(painter);
+        if (visibleAtScale(notch->depth())) {
+            notch->render(painter);
+        }
     }
 
-    // Draw match points
-    for (const MatchPoint* mp : m_matchPoints) {
-        mp->render(painter);
+    // Draw match points (8 units across)
+    if (visibleAtScale(8.0)) {
+        for (const MatchPoint* mp : m_matchPoints) {
+            mp->render(painter);
+        }
     }
 
     // Draw match point links (only when selected to avoid clutter)
@@ -278,270 +401,329 @@ void Polyline::draw(QPainter* painter, const QColor& color) const
     painter->restore();
 }
 
-QPainterPath Polyline::createPath() const
+void Polyline::geometryChanged(int movedVertex)
 {
-    QPainterPath path;
+    invalidateGeometry(movedVertex);
+    notifyChanged();
+}
 
-    if (m_vertices.isEmpty()) {
-        return path;
+void Polyline::invalidateGeometry(int movedVertex)
+{
+    ++m_revision;
+
+    // Keep a short log of single-vertex moves so dependent caches can
+    // update incrementally; older entries fold into a structural change
+    const int maxLoggedMoves = 64;
+    if (movedVertex >= 0) {
+        m_vertexMoveLog.append(qMakePair(m_revision, movedVertex));
+        if (m_vertexMoveLog.size() > maxLoggedMoves) {
+            m_structuralRevision = m_vertexMoveLog.first().first;
+            m_vertexMoveLog.removeFirst();
+        }
+    } else {
+        m_structuralRevision = m_revision;
+        m_vertexMoveLog.clear();
     }
 
-    int n = m_vertices.size();
-
-    // Start at the first vertex
-    path.moveTo(m_vertices[0].position);
+    // A single moved vertex only reshapes the segments whose control points
+    // depend on it (segments movedVertex-2 .. movedVertex+1); any other
+    // change invalidates the whole arc-length index
+    int numSegments = segmentCount();
+    if (movedVertex >= 0 && m_arcLengthsValid && numSegments > 0) {
+        int n = m_vertices.size();
+        for (int offset = -2; offset <= 1; ++offset) {
+            int seg = ((movedVertex + offset) % n + n) % n;
+            if (seg < numSegments && !m_dirtyArcSegments.contains(seg)) {
+                m_dirtyArcSegments.append(seg);
+            }
+        }
+        if (m_dirtyArcSegments.size() > numSegments / 4 + 4) {
+            m_arcLengthsValid = false;
+        }
+    } else {
+        m_arcLengthsValid = false;
+    }
+}
 
-    // Draw segments between vertices
-    for (int i = 0; i < n; ++i) {
-        int nextIdx = (i + 1) % n;
+bool Polyline::movedVerticesSince(quint64 revision, QVector<int>* movedVertices) const
+{
+    if (revision < m_structuralRevision) {
+        return false;
+    }
 
-        // If we're at the last vertex and not closed, don't draw to first
-        if (!m_closed && i == n - 1) {
-            break;
+    if (movedVertices) {
+        for (const auto& entry : m_vertexMoveLog) {
+            if (entry.first > revision && !movedVertices->contains(entry.second)) {
+                movedVertices->append(entry.second);
+            }
         }
+    }
+    return true;
+}
 
-        const PolylineVertex& current = m_vertices[i];
-        const PolylineVertex& next = m_vertices[nextIdx];
-
-        // A segment is curved if EITHER endpoint is smooth
-        bool needsCurve = (current.type == VertexType::Smooth) ||
-                          (next.type == VertexType::Smooth);
-
-        if (needsCurve) {
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
-
-            // Distance between points for scaling control points
-            QPointF segment = p2 - p1;
-            double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-            double controlDistance = dist / 3.0;
-
-            // Calculate control points for cubic Bezier
-            QPointF c1, c2;
-
-            // Determine control point c1 (outgoing from current)
-            if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
-                // Current is smooth with explicit tangent
-                c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-            } else if (current.type == VertexType::Smooth) {
-                // Current is smooth: use Catmull-Rom
-                int prevIdx = (i - 1 + n) % n;
-                QPointF p0 = m_vertices[prevIdx].position;
-                if (!m_closed && i == 0) p0 = p1;
-                c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-            } else {
-                // Current is sharp: place control point very close to p1 for sharp angle
-                c1 = p1 + (p2 - p1) * 0.01;
-            }
+const QPainterPath& Polyline::path() const
+{
+    ensureGeometryCache();
+    return m_cachedPath;
+}
+
+const QPolygonF& Polyline::flattenedOutline() const
+{
+    ensureGeometryCache();
+    return m_cachedOutline;
+}
+
+QPolygonF Polyline::flattenedOutline(double tolerance) const
+{
+    if (tolerance <= 0.0) {
+        return flattenedOutline();
+    }
+    ensureGeometryCache();
+    if (tolerance == m_cachedOutlineTolerance) {
+        return m_cachedOutline;
+    }
+    return createOutline(tolerance);
+}
+
+void Polyline::ensureGeometryCache() const
+{
+    double tolerance = CurveSegment::defaultFlatteningTolerance();
+    if (m_cacheRevision == m_revision && m_cachedOutlineTolerance == tolerance) {
+        return;
+    }
 
-            // Determine control point c2 (incoming to next)
-            if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
-                // Next is smooth with explicit tangent - symmetric control
-                c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-            } else if (next.type == VertexType::Smooth) {
-                // Next is smooth: use Catmull-Rom
-                int nextNextIdx = (i + 2) % n;
-                QPointF p3 = m_vertices[nextNextIdx].position;
-                if (!m_closed && nextIdx == n - 1) p3 = p2;
-                c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-            } else {
-                // Next is sharp: place control point very close to p2 for sharp angle
-                c2 = p2 - (p2 - p1) * 0.01;
+    // The bounds come from the control geometry, not the outline, so a
+    // change of the display tolerance (which re-flattens the outline but
+    // does not notify anyone) leaves them, and the indexes built on them,
+    // as they are
+    if (m_cacheRevision != m_revision) {
+        m_cachedBounds = m_vertices.bounds();
+        if (m_vertices.smoothCount() > 0) {
+            int numSegments = segmentCount();
+            for (int i = 0; i < numSegments; ++i) {
+                CurveSegment seg = segment(i);
+                if (seg.isCurve()) {
+                    m_cachedBounds |= seg.boundingRect();
+                }
             }
+        }
+    }
+
+    m_cachedPath = createPath();
+    m_outlineSegmentEnds.clear();
+    m_cachedOutline = createOutline(tolerance, &m_outlineSegmentEnds);
+    m_cachedOutlineTolerance = tolerance;
+    m_lodOutlines.clear();
+    m_containmentValid = false;
+    m_selfIntersectionsValid = false;
+    m_cacheRevision = m_revision;
+}
+
+QPainterPath Polyline::createPath() const
+{
+    QPainterPath path;
 
-            path.cubicTo(c1, c2, p2);
+    if (m_vertices.isEmpty()) {
+        return path;
+    }
+
+    // Start at the first vertex
+    path.moveTo(m_vertices.position(0));
+
+    // Draw segments between vertices
+    int numSegments = segmentCount();
+    for (int i = 0; i < numSegments; ++i) {
+        CurveSegment seg = segment(i);
+        if (seg.isCurve()) {
+            path.cubicTo(seg.control1(), seg.control2(), seg.end());
         } else {
             // Both endpoints are sharp: straight line
-            path.lineTo(next.position);
+            path.lineTo(seg.end());
         }
     }
 
     // Close the path if needed
-    if (m_closed && n > 2) {
+    if (m_closed && m_vertices.size() > 2) {
         path.closeSubpath();
     }
 
     return path;
 }
 
-// Helper function to calculate length of a cubic Bezier curve
-static double bezierLength(const QPointF& p0, const QPointF& c1, const QPointF& c2, const QPointF& p1)
+QPolygonF Polyline::createOutline(double tolerance, QVector<int>* segmentEnds) const
 {
-    // Use adaptive subdivision to approximate the curve length
-    // Simpson's rule integration with recursive subdivision
-    const int numSegments = 20; // Number of linear segments to approximate the curve
-    double length = 0.0;
+    QPolygonF outline;
+    if (m_vertices.isEmpty()) {
+        return outline;
+    }
 
-    for (int i = 0; i < numSegments; ++i) {
-        double t1 = static_cast<double>(i) / numSegments;
-        double t2 = static_cast<double>(i + 1) / numSegments;
-
-        // Calculate points on the Bezier curve at t1 and t2
-        auto bezierPoint = [&](double t) -> QPointF {
-            double mt = 1.0 - t;
-            double mt2 = mt * mt;
-            double mt3 = mt2 * mt;
-            double t2 = t * t;
-            double t3 = t2 * t;
-
-            return QPointF(
-                mt3 * p0.x() + 3.0 * mt2 * t * c1.x() + 3.0 * mt * t2 * c2.x() + t3 * p1.x(),
-                mt3 * p0.y() + 3.0 * mt2 * t * c1.y() + 3.0 * mt * t2 * c2.y() + t3 * p1.y()
-            );
-        };
+    // With only sharp vertices the outline is the vertex polygon itself
+    if (m_vertices.smoothCount() == 0) {
+        return m_vertices.positions();
+    }
 
-        QPointF pt1 = bezierPoint(t1);
-        QPointF pt2 = bezierPoint(t2);
+    // Straight segments contribute their end point, curves are flattened
+    // adaptively to the chord tolerance
+    outline.append(m_vertices.position(0));
+    int numSegments = segmentCount();
+    for (int i = 0; i < numSegments; ++i) {
+        segment(i).flatten(&outline, tolerance);
+        if (segmentEnds) {
+            segmentEnds->append(outline.size());
+        }
+    }
 
-        QPointF delta = pt2 - pt1;
-        length += std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+    // Closure is implied by isClosed(); drop the duplicated start point
+    if (m_closed && outline.size() > 1 && outline.first() == outline.last()) {
+        outline.removeLast();
     }
 
-    return length;
+    return outline;
 }
 
-double Polyline::calculateSegmentLength(int segmentIndex) const
+int Polyline::segmentCount() const
 {
-    if (segmentIndex < 0 || segmentIndex >= m_vertices.size()) {
-        return 0.0;
-    }
-
     int n = m_vertices.size();
-    int nextIdx = (segmentIndex + 1) % n;
+    if (n < 2) {
+        return 0;
+    }
+    return m_closed ? n : (n - 1);
+}
 
-    if (!m_closed && segmentIndex == n - 1) {
-        return 0.0; // No segment after last vertex in open polyline
+CurveSegment Polyline::segment(int segmentIndex) const
+{
+    if (segmentIndex < 0 || segmentIndex >= segmentCount()) {
+        return CurveSegment();
     }
+    return buildSegment(m_vertices, m_closed, segmentIndex);
+}
 
-    const PolylineVertex& current = m_vertices[segmentIndex];
-    const PolylineVertex& next = m_vertices[nextIdx];
+CurveSegment Polyline::segment(int segmentIndex, int overrideVertexIndex, const QPointF& overridePosition) const
+{
+    if (segmentIndex < 0 || segmentIndex >= segmentCount()) {
+        return CurveSegment();
+    }
+    return buildSegment(m_vertices, m_closed, segmentIndex, overrideVertexIndex, overridePosition);
+}
 
-    QPointF p1 = current.position;
-    QPointF p2 = next.position;
+QPointF Polyline::segmentPointAt(int segmentIndex, double fraction) const
+{
+    CurveSegment seg = segment(segmentIndex);
+    return seg.pointAt(segmentParameterAt(segmentIndex, seg, fraction));
+}
 
-    // Check if this segment is curved
-    bool needsCurve = (current.type == VertexType::Smooth) ||
-                      (next.type == VertexType::Smooth);
+QPointF Polyline::segmentTangentAt(int segmentIndex, double fraction) const
+{
+    CurveSegment seg = segment(segmentIndex);
+    return seg.tangentAt(segmentParameterAt(segmentIndex, seg, fraction));
+}
 
-    if (!needsCurve) {
-        // Straight line
-        QPointF delta = p2 - p1;
-        return std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+double Polyline::segmentParameterAt(int segmentIndex, const CurveSegment& segment, double fraction) const
+{
+    fraction = qBound(0.0, fraction, 1.0);
+    if (!segment.isCurve()) {
+        return fraction;
     }
 
-    // Calculate control points for curved segment
-    QPointF segment = p2 - p1;
-    double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-    double controlDistance = dist / 3.0;
+    // Reuse the indexed segment length instead of re-integrating it
+    ensureArcLengths();
+    double length = m_arcLengths.lengthOf(segmentIndex);
+    return segment.parameterAtLength(fraction * length, length, -1.0);
+}
 
-    QPointF c1, c2;
+void Polyline::ensureArcLengths() const
+{
+    int numSegments = segmentCount();
 
-    // Control point c1 (outgoing from current)
-    if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
-        c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-    } else if (current.type == VertexType::Smooth) {
-        int prevIdx = (segmentIndex - 1 + n) % n;
-        QPointF p0 = m_vertices[prevIdx].position;
-        if (!m_closed && segmentIndex == 0) p0 = p1;
-        c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-    } else {
-        c1 = p1 + (p2 - p1) * 0.01;
+    if (!m_arcLengthsValid || m_arcLengths.size() != numSegments) {
+        QVector<double> lengths;
+        if (m_vertices.smoothCount() == 0) {
+            lengths = m_vertices.chordLengths(m_closed);
+        } else {
+            lengths.resize(numSegments);
+            for (int i = 0; i < numSegments; ++i) {
+                lengths[i] = segment(i).length();
+            }
+        }
+        m_arcLengths.build(lengths);
+        m_arcLengthsValid = true;
+        m_dirtyArcSegments.clear();
+        return;
     }
 
-    // Control point c2 (incoming to next)
-    if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
-        c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-    } else if (next.type == VertexType::Smooth) {
-        int nextNextIdx = (segmentIndex + 2) % n;
-        QPointF p3 = m_vertices[nextNextIdx].position;
-        if (!m_closed && nextIdx == n - 1) p3 = p2;
-        c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-    } else {
-        c2 = p2 - (p2 - p1) * 0.01;
+    for (int seg : m_dirtyArcSegments) {
+        m_arcLengths.setLength(seg, segment(seg).length());
     }
+    m_dirtyArcSegments.clear();
+}
 
-    // Calculate the Bezier curve length
-    return bezierLength(p1, c1, c2, p2);
+double Polyline::perimeter() const
+{
+    ensureArcLengths();
+    return m_arcLengths.total();
 }
 
-double Polyline::calculateSegmentLength(int segmentIndex, int overrideVertexIndex, const QPointF& overridePosition) const
+double Polyline::distanceAlongContour(int segmentIndex, double fraction) const
 {
-    if (segmentIndex < 0 || segmentIndex >= m_vertices.size()) {
+    ensureArcLengths();
+    if (segmentIndex < 0 || segmentIndex >= m_arcLengths.size()) {
         return 0.0;
     }
+    return m_arcLengths.prefix(segmentIndex) +
+           qBound(0.0, fraction, 1.0) * m_arcLengths.lengthOf(segmentIndex);
+}
 
-    int n = m_vertices.size();
-    int nextIdx = (segmentIndex + 1) % n;
-
-    if (!m_closed && segmentIndex == n - 1) {
-        return 0.0;
+int Polyline::segmentAtDistance(double distance, double* fraction) const
+{
+    ensureArcLengths();
+    if (m_arcLengths.isEmpty()) {
+        if (fraction) *fraction = 0.0;
+        return -1;
     }
 
-    // Get vertices with override
-    auto getVertex = [&](int idx) -> PolylineVertex {
-        if (idx == overrideVertexIndex) {
-            PolylineVertex v = m_vertices[idx];
-            v.position = overridePosition;
-            return v;
+    // Closed contours wrap around
+    double total = m_arcLengths.total();
+    if (m_closed && total > 0.0) {
+        distance = std::fmod(distance, total);
+        if (distance < 0.0) {
+            distance += total;
         }
-        return m_vertices[idx];
-    };
-
-    const PolylineVertex current = getVertex(segmentIndex);
-    const PolylineVertex next = getVertex(nextIdx);
-
-    QPointF p1 = current.position;
-    QPointF p2 = next.position;
-
-    // Check if this segment is curved
-    bool needsCurve = (current.type == VertexType::Smooth) ||
-                      (next.type == VertexType::Smooth);
-
-    if (!needsCurve) {
-        // Straight line
-        QPointF delta = p2 - p1;
-        return std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
     }
 
-    // Calculate control points for curved segment
-    QPointF segment = p2 - p1;
-    double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-    double controlDistance = dist / 3.0;
-
-    QPointF c1, c2;
-
-    // Control point c1
-    if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
-        c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-    } else if (current.type == VertexType::Smooth) {
-        int prevIdx = (segmentIndex - 1 + n) % n;
-        QPointF p0 = getVertex(prevIdx).position;
-        if (!m_closed && segmentIndex == 0) p0 = p1;
-        c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-    } else {
-        c1 = p1 + (p2 - p1) * 0.01;
+    double offset = 0.0;
+    int seg = m_arcLengths.find(distance, &offset);
+    if (fraction) {
+        double length = m_arcLengths.lengthOf(seg);
+        *fraction = (length > 1e-10) ? offset / length : 0.0;
     }
+    return seg;
+}
 
-    // Control point c2
-    if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
-        c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-    } else if (next.type == VertexType::Smooth) {
-        int nextNextIdx = (segmentIndex + 2) % n;
-        QPointF p3 = getVertex(nextNextIdx).position;
-        if (!m_closed && nextIdx == n - 1) p3 = p2;
-        c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-    } else {
-        c2 = p2 - (p2 - p1) * 0.01;
+QPointF Polyline::pointAtDistance(double distance) const
+{
+    double fraction = 0.0;
+    int seg = segmentAtDistance(distance, &fraction);
+    if (seg < 0) {
+        return m_vertices.isEmpty() ? QPointF() : m_vertices.position(0);
     }
+    return segmentPointAt(seg, fraction);
+}
 
-    return bezierLength(p1, c1, c2, p2);
+double Polyline::calculateSegmentLength(int segmentIndex) const
+{
+    return segment(segmentIndex).length();
+}
+
+double Polyline::calculateSegmentLength(int segmentIndex, int overrideVertexIndex, const QPointF& overridePosition) const
+{
+    return segment(segmentIndex, overrideVertexIndex, overridePosition).length();
 }
 
 void Polyline::insertVertex(int index, const PolylineVertex& vertex)
 {
     if (index >= 0 && index <= m_vertices.size()) {
         m_vertices.insert(index, vertex);
-        notifyChanged();
+        geometryChanged();
     }
 }
 
@@ -550,304 +732,330 @@ void Polyline::removeVertex(int index)
     if (index >= 0 && index < m_vertices.size() && m_vertices.size() > 3) {
         // Keep at least 3 vertices for a valid polyline
         m_vertices.remove(index);
-        notifyChanged();
+        geometryChanged();
     }
 }
 
 void Polyline::updateVertex(int index, const QPointF& position)
 {
     if (index >= 0 && index < m_vertices.size()) {
-        m_vertices[index].position = position;
-        notifyChanged();
+        m_vertices.setPosition(index, position);
+        geometryChanged(index);
     }
 }
 
 void Polyline::setVertexType(int index, VertexType type)
 {
     if (index >= 0 && index < m_vertices.size()) {
-        m_vertices[index].type = type;
-        notifyChanged();
+        m_vertices.setType(index, type);
+        geometryChanged();
     }
 }
 
 PolylineVertex Polyline::vertexAt(int index) const
 {
     if (index >= 0 && index < m_vertices.size()) {
-        return m_vertices[index];
+        return m_vertices.at(index);
     }
     return PolylineVertex();
 }
 
 int Polyline::findVertexAt(const QPointF& point, double tolerance) const
 {
-    for (int i = 0; i < m_vertices.size(); ++i) {
-        QPointF delta = m_vertices[i].position - point;
+    ensurePickIndex();
+
+    // Lowest matching index, as a linear scan would find
+    int found = -1;
+    for (int proxy : m_vertexTree.queryPoint(point, tolerance)) {
+        int i = userDataToKey(m_vertexTree.userData(proxy));
+        QPointF delta = m_vertices.position(i) - point;
         double dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-        if (dist <= tolerance) {
-            return i;
+        if (dist <= tolerance && (found < 0 || i < found)) {
+            found = i;
         }
     }
-    return -1;
+    return found;
 }
 
-int Polyline::findClosestSegment(const QPointF& point, QPointF* closestPoint) const
+int Polyline::findSegmentAt(const QPointF& point, double tolerance,
+                            QPointF* closestPoint, double* tParam, double* distance) const
 {
-    if (m_vertices.size() < 2) {
-        return -1;
-    }
-
-    int closestSegment = -1;
-    double minDistance = std::numeric_limits<double>::max();
-    QPointF bestPoint;
-
-    int n = m_vertices.size();
-    int numSegments = m_closed ? n : (n - 1);
-
-    for (int i = 0; i < numSegments; ++i) {
-        int nextIdx = (i + 1) % n;
-        const PolylineVertex& current = m_vertices[i];
-        const PolylineVertex& next = m_vertices[nextIdx];
-
-        // Check if this segment is curved
-        bool needsCurve = (current.type == VertexType::Smooth) ||
-                          (next.type == VertexType::Smooth);
-
-        QPointF segmentClosestPoint;
-        double distance;
-
-        if (needsCurve) {
-            // For curved segments, sample points along the Bezier curve
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
-
-            // Calculate Bezier control points (same logic as in createPath)
-            QPointF segment = p2 - p1;
-            double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-            double controlDistance = dist / 3.0;
-
-            QPointF c1, c2;
-
-            // Control point c1 (outgoing from current)
-            if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
-                c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-            } else if (current.type == VertexType::Smooth) {
-                int prevIdx = (i - 1 + n) % n;
-                QPointF p0 = m_vertices[prevIdx].position;
-                if (!m_closed && i == 0) p0 = p1;
-                c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-            } else {
-                c1 = p1 + (p2 - p1) * 0.01;
-            }
-
-            // Control point c2 (incoming to next)
-            if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
-                c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-            } else if (next.type == VertexType::Smooth) {
-                int nextNextIdx = (i + 2) % n;
-                QPointF p3 = m_vertices[nextNextIdx].position;
-                if (!m_closed && nextIdx == n - 1) p3 = p2;
-                c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-            } else {
-                c2 = p2 - (p2 - p1) * 0.01;
-            }
-
-            // Sample points along the Bezier curve
-            double minDistOnCurve = std::numeric_limits<double>::max();
-            QPointF closestOnCurve;
-
-            const int samples = 20;  // Number of samples along the curve
-            for (int s = 0; s <= samples; ++s) {
-                double t = static_cast<double>(s) / samples;
-
-                // Cubic Bezier formula: B(t) = (1-t)³P0 + 3(1-t)²t*C1 + 3(1-t)t²*C2 + t³*P1
-                double u = 1.0 - t;
-                double tt = t * t;
-                double uu = u * u;
-                double uuu = uu * u;
-                double ttt = tt * t;
-
-                QPointF curvePoint = uuu * p1 +
-                                     3.0 * uu * t * c1 +
-                                     3.0 * u * tt * c2 +
-                                     ttt * p2;
-
-                QPointF delta = point - curvePoint;
-                double d = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-
-                if (d < minDistOnCurve) {
-                    minDistOnCurve = d;
-                    closestOnCurve = curvePoint;
-                }
-            }
+    return closestSegmentWithin(point, tolerance, closestPoint, tParam, distance);
+}
 
-            segmentClosestPoint = closestOnCurve;
-            distance = minDistOnCurve;
+int Polyline::findHandleAt(const QPointF& point, double tolerance, int* side) const
+{
+    ensurePickIndex();
 
-        } else {
-            // Straight segment - project onto line
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
+    // Lowest vertex first, incoming before outgoing handle
+    int found = -1;
+    for (int proxy : m_handleTree.queryPoint(point, tolerance)) {
+        int key = userDataToKey(m_handleTree.userData(proxy));
+        QPointF delta = handlePosition(key / 2, (key % 2) ? +1 : -1) - point;
+        double dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+        if (dist <= tolerance && (found < 0 || key < found)) {
+            found = key;
+        }
+    }
 
-            QPointF segment = p2 - p1;
-            QPointF toPoint = point - p1;
+    if (found < 0) {
+        return -1;
+    }
+    if (side) {
+        *side = (found % 2) ? +1 : -1;
+    }
+    return found / 2;
+}
 
-            double segmentLength = segment.x() * segment.x() + segment.y() * segment.y();
+int Polyline::findClosestSegment(const QPointF& point, QPointF* closestPoint) const
+{
+    return findClosestSegmentWithT(point, closestPoint, nullptr);
+}
 
-            if (segmentLength < 0.0001) {
-                continue;  // Degenerate segment
-            }
+int Polyline::findClosestSegmentWithT(const QPointF& point, QPointF* closestPoint, double* tParam,
+                                      double* distance) const
+{
+    return closestSegmentWithin(point, std::numeric_limits<double>::infinity(),
+                                closestPoint, tParam, distance);
+}
 
-            double t = (toPoint.x() * segment.x() + toPoint.y() * segment.y()) / segmentLength;
-            t = qBound(0.0, t, 1.0);
+int Polyline::closestSegmentWithin(const QPointF& point, double maxDistance,
+                                   QPointF* closestPoint, double* tParam, double* distance) const
+{
+    ensurePickIndex();
 
-            QPointF projected = p1 + segment * t;
-            QPointF delta = point - projected;
-            distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+    // Best-first over segment bounds: only segments whose control polygon
+    // bounds are closer than the best exact distance so far are evaluated,
+    // using the segments cached with the index
+    int closestSegment = -1;
+    QPointF bestPoint;
+    double bestT = 0.0;
+    double minDistance = std::numeric_limits<double>::infinity();
 
-            segmentClosestPoint = projected;
-        }
+    m_segmentTree.nearest(point, [&](int proxy) {
+        int i = userDataToKey(m_segmentTree.userData(proxy));
+        double segmentT = 0.0;
+        double segmentDistance = 0.0;
+        QPointF segmentClosestPoint = m_pickSegments[i].closestPoint(point, &segmentT, &segmentDistance);
 
-        if (distance < minDistance) {
-            minDistance = distance;
+        if (segmentDistance <= maxDistance &&
+            (segmentDistance < minDistance || (segmentDistance == minDistance && i < closestSegment))) {
+            minDistance = segmentDistance;
             closestSegment = i;
             bestPoint = segmentClosestPoint;
+            bestT = segmentT;
         }
-    }
+        return segmentDistance;
+    }, maxDistance);
 
     if (closestPoint) {
         *closestPoint = bestPoint;
     }
+    if (tParam) {
+        *tParam = bestT;
+    }
+    if (distance) {
+        *distance = (closestSegment >= 0) ? minDistance : std::numeric_limits<double>::infinity();
+    }
 
     return closestSegment;
 }
 
-int Polyline::findClosestSegmentWithT(const QPointF& point, QPointF* closestPoint, double* tParam) const
+QPointF Polyline::handlePosition(int vertexIndex, int side) const
 {
-    if (m_vertices.size() < 2) {
-        return -1;
-    }
-
-    int closestSegment = -1;
-    double minDistance = std::numeric_limits<double>::max();
-    QPointF bestPoint;
-    double bestT = 0.0;
-
     int n = m_vertices.size();
-    int numSegments = m_closed ? n : (n - 1);
-
-    for (int i = 0; i < numSegments; ++i) {
-        int nextIdx = (i + 1) % n;
-        const PolylineVertex& current = m_vertices[i];
-        const PolylineVertex& next = m_vertices[nextIdx];
-
-        bool needsCurve = (current.type == VertexType::Smooth) ||
-                          (next.type == VertexType::Smooth);
+    if (vertexIndex < 0 || vertexIndex >= n) {
+        return QPointF();
+    }
 
-        QPointF segmentClosestPoint;
-        double distance;
-        double segmentT = 0.0;
+    // Only smooth vertices have handles
+    if (!m_vertices.isSmooth(vertexIndex)) {
+        return QPointF();
+    }
 
-        if (needsCurve) {
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
-
-            QPointF segment = p2 - p1;
-            double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-            double controlDistance = dist / 3.0;
-
-            QPointF c1, c2;
-
-            if (current.type == VertexType::Smooth && current.tangent != QPointF()) {
-                c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-            } else if (current.type == VertexType::Smooth) {
-                int prevIdx = (i - 1 + n) % n;
-                QPointF p0 = m_vertices[prevIdx].position;
-                if (!m_closed && i == 0) p0 = p1;
-                c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-            } else {
-                c1 = p1 + (p2 - p1) * 0.01;
-            }
+    PolylineVertex vertex = m_vertices.at(vertexIndex);
+    QPointF vertexPos = vertex.position;
+    int prevIdx = (vertexIndex - 1 + n) % n;
+    int nextIdx = (vertexIndex + 1) % n;
+    QPointF p0 = m_vertices.position(prevIdx);
+    QPointF p2 = m_vertices.position(nextIdx);
+
+    // If explicit tangent is set, use it
+    if (vertex.tangent != QPointF()) {
+        QPointF tangent = vertex.tangent;
+        double len = std::sqrt(tangent.x() * tangent.x() + tangent.y() * tangent.y());
+        if (len > 0.001) {
+            tangent /= len;
+        }
 
-            if (next.type == VertexType::Smooth && next.tangent != QPointF()) {
-                c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-            } else if (next.type == VertexType::Smooth) {
-                int nextNextIdx = (i + 2) % n;
-                QPointF p3 = m_vertices[nextNextIdx].position;
-                if (!m_closed && nextIdx == n - 1) p3 = p2;
-                c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-            } else {
-                c2 = p2 - (p2 - p1) * 0.01;
-            }
+        // Handle distance based on neighbors
+        double dist = std::sqrt((p2 - p0).x() * (p2 - p0).x() + (p2 - p0).y() * (p2 - p0).y());
+        if (side < 0) {
+            return vertexPos - tangent * ((dist / 6.0) * vertex.incomingTension);
+        }
+        return vertexPos + tangent * ((dist / 6.0) * vertex.outgoingTension);
+    }
 
-            double minDistOnCurve = std::numeric_limits<double>::max();
-            QPointF closestOnCurve;
-            double closestT = 0.0;
+    // Catmull-Rom default
+    if (!m_closed && vertexIndex == 0) p0 = vertexPos;
+    if (!m_closed && vertexIndex == n - 1) p2 = vertexPos;
 
-            const int samples = 20;
-            for (int s = 0; s <= samples; ++s) {
-                double t = static_cast<double>(s) / samples;
-                double u = 1.0 - t;
-                double tt = t * t;
-                double uu = u * u;
-                double uuu = uu * u;
-                double ttt = tt * t;
+    QPointF tangent = (p2 - p0);
+    double len = std::sqrt(tangent.x() * tangent.x() + tangent.y() * tangent.y());
+    if (len > 0.001) {
+        tangent /= len;
+    }
 
-                QPointF curvePoint = uuu * p1 + 3.0 * uu * t * c1 + 3.0 * u * tt * c2 + ttt * p2;
+    if (side < 0) {
+        return vertexPos - tangent * ((len / 6.0) * vertex.incomingTension);
+    }
+    return vertexPos + tangent * ((len / 6.0) * vertex.outgoingTension);
+}
 
-                QPointF delta = point - curvePoint;
-                double d = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+void Polyline::ensurePickIndex() const
+{
+    if (m_pickIndexRevision == m_revision) {
+        return;
+    }
 
-                if (d < minDistOnCurve) {
-                    minDistOnCurve = d;
-                    closestOnCurve = curvePoint;
-                    closestT = t;
+    // Vertices dragged one at a time only move their own entries and those
+    // of the neighbouring segments and handles
+    QVector<int> moved;
+    int n = m_vertices.size();
+    if (m_pickIndexRevision != 0 && m_vertexProxies.size() == n &&
+        movedVerticesSince(m_pickIndexRevision, &moved) && moved.size() * 4 <= n) {
+        int numSegments = segmentCount();
+        for (int v : moved) {
+            updateVertexPick(v);
+            for (int offset = -2; offset <= 1; ++offset) {
+                int seg = ((v + offset) % n + n) % n;
+                if (seg < numSegments) {
+                    updateSegmentPick(seg);
                 }
             }
+            for (int offset = -1; offset <= 1; ++offset) {
+                updateHandlePick(((v + offset) % n + n) % n);
+            }
+        }
+    } else {
+        rebuildPickIndex();
+    }
 
-            segmentClosestPoint = closestOnCurve;
-            distance = minDistOnCurve;
-            segmentT = closestT;
-
-        } else {
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
+    m_pickIndexRevision = m_revision;
+}
 
-            QPointF segment = p2 - p1;
-            QPointF toPoint = point - p1;
+void Polyline::rebuildPickIndex() const
+{
+    int n = m_vertices.size();
+    int numSegments = segmentCount();
 
-            double segmentLength = segment.x() * segment.x() + segment.y() * segment.y();
+    m_vertexTree.clear();
+    m_segmentTree.clear();
+    m_handleTree.clear();
+    m_vertexProxies.fill(-1, n);
+    m_segmentProxies.fill(-1, numSegments);
+    m_pickSegments.resize(numSegments);
+    m_handleProxies.fill(-1, 2 * n);
 
-            if (segmentLength < 0.0001) {
-                continue;
-            }
+    for (int i = 0; i < n; ++i) {
+        updateVertexPick(i);
+        updateHandlePick(i);
+    }
+    for (int i = 0; i < numSegments; ++i) {
+        updateSegmentPick(i);
+    }
+}
 
-            double t = (toPoint.x() * segment.x() + toPoint.y() * segment.y()) / segmentLength;
-            t = qBound(0.0, t, 1.0);
+void Polyline::updateVertexPick(int vertexIndex) const
+{
+    QRectF bounds(m_vertices.position(vertexIndex), QSizeF(0.0, 0.0));
+    int& proxy = m_vertexProxies[vertexIndex];
+    if (proxy < 0) {
+        proxy = m_vertexTree.insert(bounds, keyToUserData(vertexIndex));
+    } else {
+        m_vertexTree.update(proxy, bounds);
+    }
+}
 
-            QPointF projected = p1 + segment * t;
-            QPointF delta = point - projected;
-            distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+void Polyline::updateSegmentPick(int segmentIndex) const
+{
+    m_pickSegments[segmentIndex] = segment(segmentIndex);
+    QRectF bounds = controlBounds(m_pickSegments[segmentIndex]);
+    int& proxy = m_segmentProxies[segmentIndex];
+    if (proxy < 0) {
+        proxy = m_segmentTree.insert(bounds, keyToUserData(segmentIndex));
+    } else {
+        m_segmentTree.update(proxy, bounds);
+    }
+}
 
-            segmentClosestPoint = projected;
-            segmentT = t;
+void Polyline::updateHandlePick(int vertexIndex) const
+{
+    bool smooth = m_vertices.isSmooth(vertexIndex);
+    for (int outgoing = 0; outgoing <= 1; ++outgoing) {
+        int key = 2 * vertexIndex + outgoing;
+        int& proxy = m_handleProxies[key];
+        if (!smooth) {
+            m_handleTree.remove(proxy);
+            proxy = -1;
+            continue;
         }
 
-        if (distance < minDistance) {
-            minDistance = distance;
-            closestSegment = i;
-            bestPoint = segmentClosestPoint;
-            bestT = segmentT;
+        QRectF bounds(handlePosition(vertexIndex, outgoing ? +1 : -1), QSizeF(0.0, 0.0));
+        if (proxy < 0) {
+            proxy = m_handleTree.insert(bounds, keyToUserData(key));
+        } else {
+            m_handleTree.update(proxy, bounds);
         }
     }
+}
 
-    if (closestPoint) {
-        *closestPoint = bestPoint;
+// --- Bulk vertex editing ---
+
+Polyline::VertexEditor::VertexEditor(Polyline* polyline)
+    : m_polyline(polyline)
+    , m_modified(false)
+{
+}
+
+Polyline::VertexEditor::~VertexEditor()
+{
+    commit();
+}
+
+void Polyline::VertexEditor::setPosition(int index, const QPointF& position)
+{
+    if (index >= 0 && index < m_polyline->m_vertices.size()) {
+        m_polyline->m_vertices.setPosition(index, position);
+        m_polyline->invalidateGeometry(index);
+        m_modified = true;
     }
-    if (tParam) {
-        *tParam = bestT;
+}
+
+void Polyline::VertexEditor::setVertex(int index, const PolylineVertex& vertex)
+{
+    if (index >= 0 && index < m_polyline->m_vertices.size()) {
+        // Type, tension and tangent of a vertex only shape its two adjacent
+        // segments, which the moved-vertex invalidation already covers
+        m_polyline->m_vertices.set(index, vertex);
+        m_polyline->invalidateGeometry(index);
+        m_modified = true;
     }
+}
 
-    return closestSegment;
+void Polyline::VertexEditor::setVertices(const QVector<PolylineVertex>& vertices)
+{
+    m_polyline->m_vertices.assign(vertices);
+    m_polyline->invalidateGeometry();
+    m_modified = true;
+}
+
+void Polyline::VertexEditor::commit()
+{
+    if (m_modified) {
+        m_modified = false;
+        m_polyline->notifyChanged();
+    }
 }
 
 // --- Notch management ---
@@ -931,10 +1139,11 @@ void Polyline::clearMatchPoints()
 
 Polyline* Polyline::clone(QObject* parent) const
 {
-    Polyline* copy = new Polyline(m_vertices, parent);
+    Polyline* copy = new Polyline(parent);
+    copy->m_vertices = m_vertices;
     
     // Copy basic properties
-    copy->m_closed = m_closed;
+    copy->setClosed(m_closed);
     copy->setName(name() + " Copy");
     copy->setLayer(layer());
     copy->setLineWeight(lineWeight());
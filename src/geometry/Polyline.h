@@ -8,8 +8,17 @@
 #define PATTERNCAD_POLYLINE_H
 
 #include "GeometryObject.h"
+#include "CurveSegment.h"
+#include "ArcLengthIndex.h"
+#include "AABBTree.h"
+#include "PolygonContainment.h"
+#include "SelfIntersectionFinder.h"
+#include "VertexStore.h"
 #include <QPointF>
 #include <QVector>
+#include <QPair>
+#include <QPainterPath>
+#include <QPolygonF>
 
 namespace PatternCAD {
 
@@ -21,33 +30,6 @@ class GradingSystem;
 
 namespace Geometry {
 
-/**
- * Vertex type for polyline
- */
-enum class VertexType {
-    Sharp,   // Point pointu (coin)
-    Smooth   // Point courbe (tangente continue)
-};
-
-/**
- * Vertex in a polyline with position and type
- */
-struct PolylineVertex {
-    QPointF position;
-    VertexType type;
-    double incomingTension;  // For smooth vertices: tension for incoming handle
-    double outgoingTension;  // For smooth vertices: tension for outgoing handle
-    QPointF tangent;         // For smooth vertices: direction of the tangent (outgoing)
-
-    PolylineVertex(const QPointF& pos = QPointF(), VertexType t = VertexType::Sharp,
-                   double inTens = 0.5, double outTens = 0.5, const QPointF& tang = QPointF())
-        : position(pos), type(t), incomingTension(inTens), outgoingTension(outTens), tangent(tang) {}
-
-    // Legacy constructor for backward compatibility
-    PolylineVertex(const QPointF& pos, VertexType t, double tens, const QPointF& tang)
-        : position(pos), type(t), incomingTension(tens), outgoingTension(tens), tangent(tang) {}
-};
-
 /**
  * Polyline represents a closed polygonal line with mixed vertex types:
  * - Sharp vertices (corners)
@@ -66,14 +48,47 @@ public:
     ObjectType type() const override { return ObjectType::Polyline; }
     QString typeName() const override { return "Polyline"; }
 
-    // Vertices
-    QVector<PolylineVertex> vertices() const { return m_vertices; }
+    /**
+     * Scoped bulk edit of the vertices. Mutations keep the derived caches
+     * coherent while the edit is open, but changed() is emitted only once,
+     * when the editor is committed or goes out of scope.
+     */
+    class VertexEditor
+    {
+    public:
+        explicit VertexEditor(Polyline* polyline);
+        ~VertexEditor();
+
+        VertexEditor(const VertexEditor&) = delete;
+        VertexEditor& operator=(const VertexEditor&) = delete;
+
+        int size() const { return m_polyline->m_vertices.size(); }
+        PolylineVertex at(int index) const { return m_polyline->m_vertices.at(index); }
+
+        void setPosition(int index, const QPointF& position);
+        void setVertex(int index, const PolylineVertex& vertex);
+        void setVertices(const QVector<PolylineVertex>& vertices);
+
+        // Emit changed() now if anything was modified (also done on destruction)
+        void commit();
+
+    private:
+        Polyline* m_polyline;
+        bool m_modified;
+    };
+
+    // Vertices (read-only view, no copy; invalidated by any vertex mutation
+    // that adds or removes vertices). Stored as separate coordinate, type and
+    // curve arrays, see VertexStore.
+    const VertexStore& vertices() const { return m_vertices; }
+    VertexEditor editVertices() { return VertexEditor(this); }
     void setVertices(const QVector<PolylineVertex>& vertices);
+    void setVertices(const VertexStore& vertices);
     void addVertex(const QPointF& position, VertexType type = VertexType::Sharp,
                    double tension = 0.5, const QPointF& tangent = QPointF());
     void addVertex(const PolylineVertex& vertex);
     int vertexCount() const { return m_vertices.size(); }
-    void clear() { m_vertices.clear(); notifyChanged(); }
+    void clear() { m_vertices.clear(); geometryChanged(); }
 
     // Vertex manipulation
     void insertVertex(int index, const PolylineVertex& vertex);
@@ -82,24 +97,87 @@ public:
     void setVertexType(int index, VertexType type);
     PolylineVertex vertexAt(int index) const;
 
-    // Vertex hit testing
+    // Hit testing, backed by a spatial index of vertices, segment bounds and
+    // handles (rebuilt lazily per revision, updated in place when single
+    // vertices move). Closest-segment queries only evaluate segments whose
+    // bounds are nearer than the best hit so far, and return the exact
+    // parameter and distance of the closest point.
     int findVertexAt(const QPointF& point, double tolerance = 5.0) const;
+    int findSegmentAt(const QPointF& point, double tolerance,
+                      QPointF* closestPoint = nullptr, double* tParam = nullptr,
+                      double* distance = nullptr) const;
+    int findHandleAt(const QPointF& point, double tolerance, int* side = nullptr) const;
     int findClosestSegment(const QPointF& point, QPointF* closestPoint = nullptr) const;
-    int findClosestSegmentWithT(const QPointF& point, QPointF* closestPoint, double* tParam) const;
+    int findClosestSegmentWithT(const QPointF& point, QPointF* closestPoint, double* tParam,
+                                double* distance = nullptr) const;
+
+    // Curve handle of a smooth vertex (side < 0: incoming, side > 0: outgoing).
+    // Returns a null point for sharp vertices.
+    QPointF handlePosition(int vertexIndex, int side) const;
+
+    // Segment geometry (segment i runs from vertex i to vertex i+1)
+    int segmentCount() const;
+    CurveSegment segment(int segmentIndex) const;
+    CurveSegment segment(int segmentIndex, int overrideVertexIndex, const QPointF& overridePosition) const;
+
+    // Point and unit tangent at an arc-length fraction (0-1) of a segment
+    QPointF segmentPointAt(int segmentIndex, double fraction) const;
+    QPointF segmentTangentAt(int segmentIndex, double fraction) const;
 
     // Segment length calculation (accounts for curves)
     double calculateSegmentLength(int segmentIndex) const;
     double calculateSegmentLength(int segmentIndex, int overrideVertexIndex, const QPointF& overridePosition) const;
 
+    // Arc-length queries along the contour, O(log n) via a prefix-sum index
+    // that is updated incrementally when a single vertex moves
+    double perimeter() const;
+    double distanceAlongContour(int segmentIndex, double fraction) const;
+    int segmentAtDistance(double distance, double* fraction = nullptr) const;
+    QPointF pointAtDistance(double distance) const;
+
     // Closed property
     bool isClosed() const { return m_closed; }
     void setClosed(bool closed);
 
+    // Geometry revision, bumped by every change to the vertices or the
+    // closed flag. Caches derived from the outline are keyed on it.
+    quint64 revision() const { return m_revision; }
+
+    // Vertices changed one at a time since the given revision. Returns false
+    // if anything else changed in between, in which case derived data must
+    // be rebuilt in full.
+    bool movedVerticesSince(quint64 revision, QVector<int>* movedVertices) const;
+
+    // Cached outline geometry (rebuilt lazily when the revision or the
+    // default flattening tolerance changes)
+    const QPainterPath& path() const;
+    const QPolygonF& flattenedOutline() const;  // Curves flattened to line segments, no closing duplicate
+    QPolygonF flattenedOutline(double tolerance) const;  // Explicit chord tolerance (e.g. export)
+
+    // Level-of-detail outlines for zoomed-out drawing: the flattened outline
+    // simplified (Douglas-Peucker) to within lodTolerance(level) scene units.
+    // Level 0 is full detail. Built on demand and cached with the outline.
+    static int lodLevelCount();
+    static double lodTolerance(int level);
+    static int lodLevelForScale(double pixelsPerUnit);  // Coarsest level within half a pixel
+    const QPolygonF& lodOutline(int level) const;
+
+    // Places where the flattened outline crosses, touches or runs over
+    // itself, by polyline segment. Found by a sweep over the outline on
+    // demand and cached with it.
+    struct SegmentIntersection {
+        int firstSegment;
+        int secondSegment;
+        QPointF point;
+        bool overlap;
+    };
+    const QVector<SegmentIntersection>& selfIntersections() const;
+
     // Seam allowance
     SeamAllowance* seamAllowance() const { return m_seamAllowance; }
 
     // Notches (story-004-02)
-    QVector<Notch*> notches() const { return m_notches; }
+    const QVector<Notch*>& notches() const { return m_notches; }
     void addNotch(Notch* notch);
     void removeNotch(Notch* notch);
     Notch* notchAt(int index) const;
@@ -107,7 +185,7 @@ public:
     void clearNotches();
 
     // Match Points (story-004-03)
-    QVector<MatchPoint*> matchPoints() const { return m_matchPoints; }
+    const QVector<MatchPoint*>& matchPoints() const { return m_matchPoints; }
     void addMatchPoint(MatchPoint* mp);
     void removeMatchPoint(MatchPoint* mp);
     MatchPoint* matchPointAt(int index) const;
@@ -123,25 +201,75 @@ public:
 
     // Geometry interface
     QRectF boundingRect() const override;
+    QRectF paintBounds() const override;
     bool contains(const QPointF& point) const override;
     void translate(const QPointF& delta) override;
     void rotate(double angleDegrees, const QPointF& center) override;
     void mirror(const QPointF& axisPoint1, const QPointF& axisPoint2) override;
     void scale(double scaleX, double scaleY, const QPointF& origin) override;
+    void transform(const QTransform& matrix) override;
 
     // Drawing
     void draw(QPainter* painter, const QColor& color = Qt::black) const override;
+    void drawAtScale(QPainter* painter, const QColor& color, double pixelsPerUnit) const override;
 
 private:
-    QVector<PolylineVertex> m_vertices;
+    VertexStore m_vertices;
     bool m_closed;
     SeamAllowance* m_seamAllowance;
     QVector<Notch*> m_notches;
     QVector<MatchPoint*> m_matchPoints;
     GradingSystem* m_gradingSystem;
 
+    // Geometry cache, valid while m_cacheRevision == m_revision
+    quint64 m_revision;
+    mutable quint64 m_cacheRevision;
+    mutable QPainterPath m_cachedPath;
+    mutable QPolygonF m_cachedOutline;
+    mutable double m_cachedOutlineTolerance;
+    mutable QRectF m_cachedBounds;  // From the control geometry, whatever the tolerance
+    mutable QVector<QPolygonF> m_lodOutlines;  // Index = level; empty entries not built yet
+    mutable PolygonContainment m_containment;  // Over m_cachedOutline, built on first contains()
+    mutable bool m_containmentValid;
+    mutable QVector<int> m_outlineSegmentEnds;  // Outline size after each segment; empty if all straight
+    mutable QVector<SegmentIntersection> m_selfIntersections;
+    mutable bool m_selfIntersectionsValid;
+
+    // Single-vertex changes since m_structuralRevision, as (revision, vertex)
+    QVector<QPair<quint64, int>> m_vertexMoveLog;
+    quint64 m_structuralRevision;
+
+    // Segment arc lengths; m_dirtyArcSegments lists segments to re-measure
+    mutable ArcLengthIndex m_arcLengths;
+    mutable bool m_arcLengthsValid;
+    mutable QVector<int> m_dirtyArcSegments;
+
+    // Hit-test index, valid while m_pickIndexRevision == m_revision.
+    // Handle keys are 2 * vertex + (outgoing ? 1 : 0).
+    mutable AABBTree m_vertexTree;
+    mutable AABBTree m_segmentTree;
+    mutable AABBTree m_handleTree;
+    mutable QVector<int> m_vertexProxies;
+    mutable QVector<int> m_segmentProxies;
+    mutable QVector<int> m_handleProxies;  // -1 for handles of sharp vertices
+    mutable QVector<CurveSegment> m_pickSegments;  // Segments as indexed
+    mutable quint64 m_pickIndexRevision;
+
     // Helper methods
+    void geometryChanged(int movedVertex = -1);
+    void invalidateGeometry(int movedVertex = -1);
+    void ensureGeometryCache() const;
+    void ensureArcLengths() const;
+    void ensurePickIndex() const;
+    void rebuildPickIndex() const;
+    void updateVertexPick(int vertexIndex) const;
+    void updateSegmentPick(int segmentIndex) const;
+    void updateHandlePick(int vertexIndex) const;
+    int closestSegmentWithin(const QPointF& point, double maxDistance,
+                             QPointF* closestPoint, double* tParam, double* distance) const;
+    double segmentParameterAt(int segmentIndex, const CurveSegment& segment, double fraction) const;
     QPainterPath createPath() const;
+    QPolygonF createOutline(double tolerance, QVector<int>* segmentEnds = nullptr) const;
 };
 
 } // namespace Geometry
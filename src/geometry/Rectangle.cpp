@@ -290,6 +290,15 @@ void Rectangle::scale(double scaleX, double scaleY, const QPointF& origin)
     setHeight(maxY - minY);
 }
 
+void Rectangle::transform(const QTransform& matrix)
+{
+    // Axis-aligned bounding rect of the transformed corners
+    QRectF bounds = matrix.mapRect(QRectF(m_topLeft, QSizeF(m_width, m_height)));
+    setTopLeft(bounds.topLeft());
+    setWidth(bounds.width());
+    setHeight(bounds.height());
+}
+
 void Rectangle::draw(QPainter* painter, const QColor& color) const
 {
     if (!m_visible) {
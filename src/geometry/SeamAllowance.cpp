@@ -21,6 +21,11 @@ SeamAllowance::SeamAllowance(QObject* parent)
     , m_cornerType(CornerType::Miter)
     , m_enabled(false)
     , m_width(10.0)
+    , m_cachedPolylineRevision(0)
+    , m_cachedTolerance(0.0)
+    , m_cachedOutsideSign(0.0)
+    , m_cacheValid(false)
+    , m_crossingsValid(false)
 {
 }
 
@@ -28,11 +33,17 @@ SeamAllowance::~SeamAllowance()
 {
 }
 
+void SeamAllowance::settingsChanged()
+{
+    m_cacheValid = false;
+    emit changed();
+}
+
 void SeamAllowance::setWidth(double width)
 {
     if (m_width != width) {
         m_width = width;
-        emit changed();
+        settingsChanged();
     }
 }
 
@@ -40,7 +51,7 @@ void SeamAllowance::setCornerType(CornerType type)
 {
     if (m_cornerType != type) {
         m_cornerType = type;
-        emit changed();
+        settingsChanged();
     }
 }
 
@@ -48,7 +59,7 @@ void SeamAllowance::setEnabled(bool enabled)
 {
     if (m_enabled != enabled) {
         m_enabled = enabled;
-        emit changed();
+        settingsChanged();
     }
 }
 
@@ -56,7 +67,7 @@ void SeamAllowance::setSourcePolyline(Geometry::Polyline* polyline)
 {
     if (m_sourcePolyline != polyline) {
         m_sourcePolyline = polyline;
-        emit changed();
+        settingsChanged();
     }
 }
 
@@ -97,7 +108,7 @@ void SeamAllowance::addRange(int startVertexIndex, int endVertexIndex, double wi
             m_ranges.append(range);
         }
         m_enabled = !m_ranges.isEmpty();
-        emit changed();
+        settingsChanged();
         return;
     }
     
@@ -197,7 +208,7 @@ void SeamAllowance::addRange(int startVertexIndex, int endVertexIndex, double wi
     }
     
     m_enabled = !m_ranges.isEmpty();
-    emit changed();
+    settingsChanged();
 }
 
 void SeamAllowance::addFullContour(double width)
@@ -207,7 +218,7 @@ void SeamAllowance::addFullContour(double width)
     range.width = width;
     m_ranges.append(range);
     m_enabled = true;
-    emit changed();
+    settingsChanged();
 }
 
 void SeamAllowance::removeRange(int index)
@@ -217,7 +228,7 @@ void SeamAllowance::removeRange(int index)
         if (m_ranges.isEmpty()) {
             m_enabled = false;
         }
-        emit changed();
+        settingsChanged();
     }
 }
 
@@ -225,7 +236,7 @@ void SeamAllowance::clearRanges()
 {
     m_ranges.clear();
     m_enabled = false;
-    emit changed();
+    settingsChanged();
 }
 
 // Legacy single-range API (for compatibility)
@@ -304,24 +315,56 @@ void SeamAllowance::clearRange()
 }
 
 // Main computation - returns all offset polygons
-QVector<QVector<QPointF>> SeamAllowance::computeAllOffsets() const
+const QVector<QVector<QPointF>>& SeamAllowance::computeAllOffsets() const
 {
+    ensureOffsets();
+    return m_cachedOffsets;
+}
+
+QVector<QVector<QPointF>> SeamAllowance::computeAllOffsets(double flatteningTolerance) const
+{
+    if (flatteningTolerance <= 0.0 ||
+        flatteningTolerance == Geometry::CurveSegment::defaultFlatteningTolerance()) {
+        return computeAllOffsets();
+    }
+
     QVector<QVector<QPointF>> allOffsets;
-    
     if (!m_sourcePolyline || !m_enabled) {
         return allOffsets;
     }
-    
+
     for (const auto& range : m_ranges) {
-        QVector<QPointF> offset = computeRangeOffset(range);
+        QVector<QPointF> offset = computeRangeOffset(range, flatteningTolerance);
         if (!offset.isEmpty()) {
             allOffsets.append(offset);
         }
     }
-    
     return allOffsets;
 }
 
+const QVector<QPointF>& SeamAllowance::selfIntersections() const
+{
+    ensureOffsets();
+    if (m_crossingsValid) {
+        return m_cachedCrossings;
+    }
+
+    m_cachedCrossings.clear();
+    for (int i = 0; i < m_rangeOffsets.size(); ++i) {
+        if (!m_rangeCrossingsValid[i]) {
+            m_rangeCrossings[i].clear();
+            const auto hits = Geometry::SelfIntersectionFinder::find(QPolygonF(m_rangeOffsets[i]), true);
+            for (const auto& hit : hits) {
+                m_rangeCrossings[i].append(hit.point);
+            }
+            m_rangeCrossingsValid[i] = true;
+        }
+        m_cachedCrossings += m_rangeCrossings[i];
+    }
+    m_crossingsValid = true;
+    return m_cachedCrossings;
+}
+
 // Legacy single offset (returns first range only)
 QVector<QPointF> SeamAllowance::computeOffset() const
 {
@@ -330,17 +373,107 @@ QVector<QPointF> SeamAllowance::computeOffset() const
     }
     
     // Return first range for backwards compatibility
-    return computeRangeOffset(m_ranges.first());
+    ensureOffsets();
+    return m_rangeOffsets.first();
+}
+
+void SeamAllowance::ensureOffsets() const
+{
+    quint64 revision = m_sourcePolyline ? m_sourcePolyline->revision() : 0;
+    double tolerance = Geometry::CurveSegment::defaultFlatteningTolerance();
+    if (m_cacheValid && m_cachedPolylineRevision == revision && m_cachedTolerance == tolerance) {
+        return;
+    }
+
+    if (!m_sourcePolyline || !m_enabled) {
+        m_rangeOffsets.clear();
+        m_cachedOffsets.clear();
+        m_cachedRenderPath = QPainterPath();
+        m_rangeCrossings.clear();
+        m_rangeCrossingsValid.clear();
+        m_crossingsValid = false;
+        m_cachedPolylineRevision = revision;
+        m_cachedTolerance = tolerance;
+        m_cacheValid = true;
+        return;
+    }
+
+    // Partial ranges only depend on the segments they cover, unless the
+    // contour orientation (and with it the outside direction) flipped
+    QVector<int> movedVertices;
+    double sign = outsideSign();
+    bool incremental = m_cacheValid &&
+                       m_cachedTolerance == tolerance &&
+                       m_rangeOffsets.size() == m_ranges.size() &&
+                       sign == m_cachedOutsideSign &&
+                       m_sourcePolyline->movedVerticesSince(m_cachedPolylineRevision, &movedVertices);
+
+    int n = m_sourcePolyline->vertexCount();
+    m_rangeOffsets.resize(m_ranges.size());
+    m_rangeCrossings.resize(m_ranges.size());
+    m_rangeCrossingsValid.resize(m_ranges.size());
+    for (int i = 0; i < m_ranges.size(); ++i) {
+        if (!incremental || isRangeAffected(m_ranges[i], movedVertices, n)) {
+            m_rangeOffsets[i] = computeRangeOffset(m_ranges[i], tolerance);
+            m_rangeCrossingsValid[i] = false;
+            m_crossingsValid = false;
+        }
+    }
+
+    m_cachedOffsets.clear();
+    m_cachedRenderPath = QPainterPath();
+    for (const auto& offset : m_rangeOffsets) {
+        if (offset.isEmpty()) continue;
+
+        m_cachedOffsets.append(offset);
+        m_cachedRenderPath.moveTo(offset.first());
+        for (int i = 1; i < offset.size(); ++i) {
+            m_cachedRenderPath.lineTo(offset[i]);
+        }
+        m_cachedRenderPath.closeSubpath();
+    }
+
+    m_cachedPolylineRevision = revision;
+    m_cachedTolerance = tolerance;
+    m_cachedOutsideSign = sign;
+    m_cacheValid = true;
+}
+
+bool SeamAllowance::isRangeAffected(const SeamRange& range, const QVector<int>& movedVertices, int vertexCount) const
+{
+    if (range.isFullContour || range.startVertexIndex == range.endVertexIndex) {
+        return !movedVertices.isEmpty();
+    }
+
+    // A vertex shapes segments v-2 .. v+1 (Catmull-Rom neighbours); the
+    // range covers segments start .. end-1
+    for (int v : movedVertices) {
+        for (int offset = -2; offset <= 1; ++offset) {
+            int seg = ((v + offset) % vertexCount + vertexCount) % vertexCount;
+            if (isVertexInRange(seg, range.startVertexIndex, range.endVertexIndex, vertexCount) &&
+                seg != range.endVertexIndex) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+double SeamAllowance::outsideSign() const
+{
+    // Polygon signed area gives the winding direction; outsideSign selects
+    // which perpendicular direction is "outside"
+    return (m_sourcePolyline->vertices().signedArea() > 0) ? -1.0 : 1.0;
 }
 
 // Compute offset for a single range
-QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range) const
+QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range, double flatteningTolerance) const
 {
     if (!m_sourcePolyline || range.width <= 0.0 || !range.isValid()) {
         return QVector<QPointF>();
     }
 
-    QVector<Geometry::PolylineVertex> vertices = m_sourcePolyline->vertices();
+    const Geometry::VertexStore& vertices = m_sourcePolyline->vertices();
     if (vertices.size() < 3) {
         return QVector<QPointF>();
     }
@@ -369,17 +502,13 @@ QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range) const
         PathD path;
         
         for (int i = 0; i < n; ++i) {
-            int nextIdx = (i + 1) % n;
             const Geometry::PolylineVertex& current = vertices[i];
-            const Geometry::PolylineVertex& next = vertices[nextIdx];
             
             path.push_back(PointD(current.position.x(), current.position.y()));
             
-            bool needsCurve = (current.type == Geometry::VertexType::Smooth) ||
-                              (next.type == Geometry::VertexType::Smooth);
-            
-            if (needsCurve) {
-                addCurvePoints(path, current, next, i, vertices);
+            Geometry::CurveSegment segment = m_sourcePolyline->segment(i);
+            if (segment.isCurve()) {
+                addCurvePoints(path, segment, flatteningTolerance);
             }
         }
         
@@ -398,15 +527,8 @@ QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range) const
         // Endpoints: simple perpendicular offset (gives perpendicular termination)
         // Interior points: proper miter calculation (bisector, length = width/cos(halfAngle))
         
-        // Compute polygon signed area to determine winding direction (outside direction)
-        double signedArea = 0.0;
-        for (int i = 0; i < n; ++i) {
-            int j = (i + 1) % n;
-            signedArea += vertices[i].position.x() * vertices[j].position.y();
-            signedArea -= vertices[j].position.x() * vertices[i].position.y();
-        }
-        // outsideSign determines which perpendicular direction is "outside"
-        double outsideSign = (signedArea > 0) ? -1.0 : 1.0;
+        // Winding direction determines which side is outside
+        double outsideSign = this->outsideSign();
         
         // Build range points including curve samples
         QVector<QPointF> rangePoints;
@@ -414,15 +536,13 @@ QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range) const
         while (idx != range.endVertexIndex) {
             int nextIdx = (idx + 1) % n;
             const Geometry::PolylineVertex& v1 = vertices[idx];
-            const Geometry::PolylineVertex& v2 = vertices[nextIdx];
             
             rangePoints.append(v1.position);
             
-            bool needsCurve = (v1.type == Geometry::VertexType::Smooth) ||
-                              (v2.type == Geometry::VertexType::Smooth);
-            if (needsCurve) {
+            Geometry::CurveSegment segment = m_sourcePolyline->segment(idx);
+            if (segment.isCurve()) {
                 PathD curvePath;
-                addCurvePoints(curvePath, v1, v2, idx, vertices);
+                addCurvePoints(curvePath, segment, flatteningTolerance);
                 for (const auto& pt : curvePath) {
                     rangePoints.append(QPointF(pt.x, pt.y));
                 }
@@ -531,53 +651,14 @@ QVector<QPointF> SeamAllowance::computeRangeOffset(const SeamRange& range) const
     }
 }
 
-void SeamAllowance::addCurvePoints(PathD& path, 
-                                    const Geometry::PolylineVertex& current,
-                                    const Geometry::PolylineVertex& next,
-                                    int currentIdx,
-                                    const QVector<Geometry::PolylineVertex>& vertices) const
+void SeamAllowance::addCurvePoints(PathD& path, const Geometry::CurveSegment& segment,
+                                   double flatteningTolerance) const
 {
-    int n = vertices.size();
-    QPointF p1 = current.position;
-    QPointF p2 = next.position;
-    
-    QPointF segment = p2 - p1;
-    double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-    double controlDistance = dist / 3.0;
-    
-    QPointF c1, c2;
-    
-    if (current.type == Geometry::VertexType::Smooth && current.tangent != QPointF()) {
-        c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-    } else if (current.type == Geometry::VertexType::Smooth) {
-        int prevIdx = (currentIdx - 1 + n) % n;
-        QPointF p0 = vertices[prevIdx].position;
-        c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-    } else {
-        c1 = p1 + (p2 - p1) * 0.01;
-    }
-    
-    if (next.type == Geometry::VertexType::Smooth && next.tangent != QPointF()) {
-        c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-    } else if (next.type == Geometry::VertexType::Smooth) {
-        int nextNextIdx = (currentIdx + 2) % n;
-        QPointF p3 = vertices[nextNextIdx].position;
-        c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-    } else {
-        c2 = p2 - (p2 - p1) * 0.01;
-    }
-    
-    const int segments = 20;
-    for (int j = 1; j < segments; ++j) {
-        double t = static_cast<double>(j) / segments;
-        double t2 = t * t;
-        double t3 = t2 * t;
-        double mt = 1.0 - t;
-        double mt2 = mt * mt;
-        double mt3 = mt2 * mt;
-        
-        QPointF point = p1 * mt3 + c1 * 3.0 * mt2 * t + c2 * 3.0 * mt * t2 + p2 * t3;
-        path.push_back(PointD(point.x(), point.y()));
+    // Interior points only: the segment end is the next vertex, added by the caller
+    QVector<QPointF> points;
+    segment.flatten(&points, flatteningTolerance);
+    for (int j = 0; j + 1 < points.size(); ++j) {
+        path.push_back(PointD(points[j].x(), points[j].y()));
     }
 }
 
@@ -597,22 +678,20 @@ void SeamAllowance::render(QPainter* painter, const QColor& color) const
     painter->setBrush(Qt::NoBrush);
 
     // Draw ALL offset paths
-    QVector<QVector<QPointF>> allOffsets = computeAllOffsets();
-    
-    for (const auto& offset : allOffsets) {
-        if (offset.isEmpty()) continue;
-        
-        QPainterPath path;
-        path.moveTo(offset.first());
-        for (int i = 1; i < offset.size(); ++i) {
-            path.lineTo(offset[i]);
-        }
-        path.closeSubpath();
-        
-        painter->drawPath(path);
-    }
+    ensureOffsets();
+    painter->drawPath(m_cachedRenderPath);
 
     painter->restore();
 }
 
+QRectF SeamAllowance::boundingRect() const
+{
+    if (!m_enabled || m_ranges.isEmpty()) {
+        return QRectF();
+    }
+
+    ensureOffsets();
+    return m_cachedRenderPath.boundingRect();
+}
+
 } // namespace PatternCAD
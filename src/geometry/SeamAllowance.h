@@ -11,6 +11,7 @@
 #include <QPointF>
 #include <QVector>
 #include <QPainter>
+#include <QPainterPath>
 #include "Polyline.h"
 #include <clipper2/clipper.h>
 
@@ -87,14 +88,26 @@ public:
     bool isEdgeInRange(int edgeIndex) const;
     void clearRange();
 
-    // Computation - returns all offset polygons
-    QVector<QVector<QPointF>> computeAllOffsets() const;
+    // Computation - returns all offset polygons. Results are cached against
+    // the source polyline revision and the seam settings; when only single
+    // vertices moved, just the ranges touching them are recomputed.
+    const QVector<QVector<QPointF>>& computeAllOffsets() const;
+
+    // Same, with curves flattened to an explicit chord tolerance (e.g. for
+    // plotter export). Uses the cache when the tolerance matches it.
+    QVector<QVector<QPointF>> computeAllOffsets(double flatteningTolerance) const;
     
     // Legacy single offset (returns first range only)
     QVector<QPointF> computeOffset() const;
 
+    // Points where an offset outline crosses or runs over itself. Swept on
+    // demand per range; only ranges whose offsets were recomputed since the
+    // last call are swept again.
+    const QVector<QPointF>& selfIntersections() const;
+
     // Rendering
     void render(QPainter* painter, const QColor& color = Qt::red) const;
+    QRectF boundingRect() const;  // Extent of the rendered outlines (null when nothing is drawn)
 
 signals:
     void changed();
@@ -110,13 +123,30 @@ private:
     // Legacy single range (for compatibility)
     double m_width;
     
+    // Offset cache: one outline per range, the non-empty outlines in range
+    // order (as returned by computeAllOffsets) and the path drawn by render()
+    mutable QVector<QVector<QPointF>> m_rangeOffsets;
+    mutable QVector<QVector<QPointF>> m_cachedOffsets;
+    mutable QPainterPath m_cachedRenderPath;
+    mutable quint64 m_cachedPolylineRevision;
+    mutable double m_cachedTolerance;
+    mutable double m_cachedOutsideSign;
+    mutable bool m_cacheValid;
+
+    // Self-intersections per range offset, and all of them in range order
+    mutable QVector<QVector<QPointF>> m_rangeCrossings;
+    mutable QVector<bool> m_rangeCrossingsValid;
+    mutable QVector<QPointF> m_cachedCrossings;
+    mutable bool m_crossingsValid;
+
     // Helper methods
-    QVector<QPointF> computeRangeOffset(const SeamRange& range) const;
-    void addCurvePoints(Clipper2Lib::PathD& path, 
-                        const Geometry::PolylineVertex& current,
-                        const Geometry::PolylineVertex& next,
-                        int currentIdx,
-                        const QVector<Geometry::PolylineVertex>& vertices) const;
+    void settingsChanged();
+    void ensureOffsets() const;
+    bool isRangeAffected(const SeamRange& range, const QVector<int>& movedVertices, int vertexCount) const;
+    double outsideSign() const;
+    QVector<QPointF> computeRangeOffset(const SeamRange& range, double flatteningTolerance) const;
+    void addCurvePoints(Clipper2Lib::PathD& path, const Geometry::CurveSegment& segment,
+                        double flatteningTolerance) const;
 };
 
 } // namespace PatternCAD
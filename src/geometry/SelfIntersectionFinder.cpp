@@ -0,0 +1,169 @@
+/**
+ * SelfIntersectionFinder.cpp
+ *
+ * Implementation of SelfIntersectionFinder
+ */
+
+#include "SelfIntersectionFinder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PatternCAD {
+namespace Geometry {
+
+namespace {
+    double cross(const QPointF& a, const QPointF& b)
+    {
+        return a.x() * b.y() - a.y() * b.x();
+    }
+
+    double dot(const QPointF& a, const QPointF& b)
+    {
+        return a.x() * b.x() + a.y() * b.y();
+    }
+
+    // Relative tolerance for parallel and collinear tests
+    const double kParallelTolerance = 1e-12;
+}
+
+QVector<EdgeIntersection> SelfIntersectionFinder::find(const QPolygonF& points, bool closed)
+{
+    QVector<EdgeIntersection> result;
+
+    // Drop consecutive duplicates so every edge has a length and adjacency
+    // is plain index adjacency. vertices[k] is the last input index of the
+    // k-th run of equal points, so edge k maps to input edge vertices[k].
+    QVector<int> vertices;
+    vertices.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i) {
+        if (vertices.isEmpty() || points[i] != points[vertices.last()]) {
+            vertices.append(i);
+        } else {
+            vertices.last() = i;
+        }
+    }
+    if (closed && vertices.size() > 1 && points[vertices.first()] == points[vertices.last()]) {
+        vertices.removeLast();
+    }
+
+    int n = vertices.size();
+    int edgeCount = closed ? n : n - 1;
+    if (n < 3 || edgeCount < 2) {
+        return result;
+    }
+
+    auto start = [&](int e) { return points[vertices[e]]; };
+    auto end = [&](int e) { return points[vertices[(e + 1 == n) ? 0 : e + 1]]; };
+
+    // Sweep events: edges by their left end
+    QVector<int> order(edgeCount);
+    QVector<double> minX(edgeCount);
+    QVector<double> maxX(edgeCount);
+    for (int e = 0; e < edgeCount; ++e) {
+        order[e] = e;
+        minX[e] = std::min(start(e).x(), end(e).x());
+        maxX[e] = std::max(start(e).x(), end(e).x());
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return minX[a] < minX[b]; });
+
+    QVector<int> active;
+    for (int e : order) {
+        // Retire edges that end left of this one
+        for (int i = active.size() - 1; i >= 0; --i) {
+            if (maxX[active[i]] < minX[e]) {
+                active[i] = active.last();
+                active.removeLast();
+            }
+        }
+
+        QPointF e0 = start(e);
+        QPointF e1 = end(e);
+        double minY = std::min(e0.y(), e1.y());
+        double maxY = std::max(e0.y(), e1.y());
+        for (int other : active) {
+            QPointF o0 = start(other);
+            QPointF o1 = end(other);
+            if (std::max(o0.y(), o1.y()) < minY || std::min(o0.y(), o1.y()) > maxY) {
+                continue;
+            }
+
+            int first = std::min(e, other);
+            int second = std::max(e, other);
+            bool adjacent = (second == first + 1) || (closed && first == 0 && second == edgeCount - 1);
+
+            // Orient adjacent pairs so the shared vertex is first.end == second.start
+            EdgeIntersection hit;
+            bool found = (first == 0 && second == edgeCount - 1 && closed)
+                ? intersect(start(second), end(second), start(first), end(first), adjacent, &hit)
+                : intersect(start(first), end(first), start(second), end(second), adjacent, &hit);
+            if (found) {
+                hit.firstEdge = vertices[first];
+                hit.secondEdge = vertices[second];
+                result.append(hit);
+            }
+        }
+        active.append(e);
+    }
+
+    std::sort(result.begin(), result.end(), [](const EdgeIntersection& a, const EdgeIntersection& b) {
+        return a.firstEdge != b.firstEdge ? a.firstEdge < b.firstEdge : a.secondEdge < b.secondEdge;
+    });
+    return result;
+}
+
+bool SelfIntersectionFinder::intersect(const QPointF& a0, const QPointF& a1, const QPointF& b0, const QPointF& b1,
+                                       bool adjacent, EdgeIntersection* result)
+{
+    QPointF r = a1 - a0;
+    QPointF s = b1 - b0;
+    QPointF q = b0 - a0;
+    double rLengthSquared = dot(r, r);
+    double sLengthSquared = dot(s, s);
+    double denominator = cross(r, s);
+    double scale = std::sqrt(rLengthSquared * sLengthSquared);
+
+    if (std::abs(denominator) > kParallelTolerance * scale) {
+        // Adjacent edges that are not parallel only share their vertex
+        if (adjacent) {
+            return false;
+        }
+        double t = cross(q, s) / denominator;
+        double u = cross(q, r) / denominator;
+        if (t < 0.0 || t > 1.0 || u < 0.0 || u > 1.0) {
+            return false;
+        }
+        result->point = a0 + r * t;
+        result->overlap = false;
+        return true;
+    }
+
+    // Parallel: only collinear edges can meet
+    if (std::abs(cross(q, r)) > kParallelTolerance * std::sqrt(dot(q, q) * rLengthSquared)) {
+        return false;
+    }
+
+    // Adjacent collinear edges overlap only when the second folds back
+    if (adjacent) {
+        if (dot(r, s) >= 0.0) {
+            return false;
+        }
+        result->point = a1;
+        result->overlap = true;
+        return true;
+    }
+
+    // Extent of b along a, in units of a's parameter
+    double t0 = dot(q, r) / rLengthSquared;
+    double t1 = dot(b1 - a0, r) / rLengthSquared;
+    double low = std::max(0.0, std::min(t0, t1));
+    double high = std::min(1.0, std::max(t0, t1));
+    if (low > high) {
+        return false;
+    }
+    result->point = a0 + r * low;
+    result->overlap = high > low;
+    return true;
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
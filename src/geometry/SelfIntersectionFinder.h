@@ -0,0 +1,51 @@
+/**
+ * SelfIntersectionFinder.h
+ *
+ * Sweep-line detection of self-intersections in flattened outlines
+ */
+
+#ifndef PATTERNCAD_SELFINTERSECTIONFINDER_H
+#define PATTERNCAD_SELFINTERSECTIONFINDER_H
+
+#include <QPolygonF>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * A pair of outline edges that cross, touch or overlap. Edge i runs from
+ * point i to point i + 1 (the closing edge of a closed outline ends at
+ * point 0). For overlaps, point is one end of the shared stretch.
+ */
+struct EdgeIntersection {
+    int firstEdge;   // Lower edge index
+    int secondEdge;
+    QPointF point;
+    bool overlap;    // Collinear edges sharing a stretch, rather than a point
+};
+
+/**
+ * SelfIntersectionFinder reports the non-adjacent edge pairs of an outline
+ * that meet, plus adjacent edges that fold back onto each other. Edges are
+ * swept in order of their left end; an edge is only tested against the
+ * edges still active (spanning its x) whose y ranges overlap it. Outlines
+ * cross a vertical line a handful of times, so the active set stays small
+ * and the cost is O(n log n + k) in practice.
+ */
+class SelfIntersectionFinder
+{
+public:
+    // Outline given without a closing duplicate point. Consecutive
+    // duplicate points are ignored.
+    static QVector<EdgeIntersection> find(const QPolygonF& points, bool closed);
+
+private:
+    static bool intersect(const QPointF& a0, const QPointF& a1, const QPointF& b0, const QPointF& b1,
+                          bool adjacent, EdgeIntersection* result);
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_SELFINTERSECTIONFINDER_H
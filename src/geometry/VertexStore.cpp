@@ -0,0 +1,327 @@
+/**
+ * VertexStore.cpp
+ *
+ * Implementation of VertexStore
+ */
+
+#include "VertexStore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PatternCAD {
+namespace Geometry {
+
+VertexStore::VertexStore()
+    : m_smoothCount(0)
+{
+}
+
+VertexStore::VertexStore(const QVector<PolylineVertex>& vertices)
+    : m_smoothCount(0)
+{
+    assign(vertices);
+}
+
+void VertexStore::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_smooth.clear();
+    m_smoothCount = 0;
+    m_inTension.clear();
+    m_outTension.clear();
+    m_tangentX.clear();
+    m_tangentY.clear();
+}
+
+void VertexStore::reserve(int size)
+{
+    m_x.reserve(size);
+    m_y.reserve(size);
+}
+
+PolylineVertex VertexStore::at(int index) const
+{
+    return PolylineVertex(position(index), type(index),
+                          incomingTension(index), outgoingTension(index), tangent(index));
+}
+
+void VertexStore::set(int index, const PolylineVertex& vertex)
+{
+    setPosition(index, vertex.position);
+    setType(index, vertex.type);
+    setCurveData(index, vertex);
+}
+
+void VertexStore::setType(int index, VertexType type)
+{
+    bool smooth = (type == VertexType::Smooth);
+    if (m_smooth.testBit(index) != smooth) {
+        m_smooth.setBit(index, smooth);
+        m_smoothCount += smooth ? 1 : -1;
+    }
+}
+
+void VertexStore::append(const PolylineVertex& vertex)
+{
+    insert(size(), vertex);
+}
+
+void VertexStore::insert(int index, const PolylineVertex& vertex)
+{
+    int n = size();
+    m_x.insert(index, vertex.position.x());
+    m_y.insert(index, vertex.position.y());
+
+    // QBitArray has no insert; shift the tail up by one
+    m_smooth.resize(n + 1);
+    for (int i = n; i > index; --i) {
+        m_smooth.setBit(i, m_smooth.testBit(i - 1));
+    }
+    bool smooth = (vertex.type == VertexType::Smooth);
+    m_smooth.setBit(index, smooth);
+    m_smoothCount += smooth ? 1 : 0;
+
+    if (!m_inTension.isEmpty()) {
+        m_inTension.insert(index, vertex.incomingTension);
+        m_outTension.insert(index, vertex.outgoingTension);
+        m_tangentX.insert(index, vertex.tangent.x());
+        m_tangentY.insert(index, vertex.tangent.y());
+    } else if (!hasDefaultCurveData(vertex)) {
+        ensureCurveData();
+        setCurveData(index, vertex);
+    }
+}
+
+void VertexStore::remove(int index)
+{
+    int n = size();
+    m_smoothCount -= m_smooth.testBit(index) ? 1 : 0;
+    for (int i = index; i < n - 1; ++i) {
+        m_smooth.setBit(i, m_smooth.testBit(i + 1));
+    }
+    m_smooth.resize(n - 1);
+
+    m_x.remove(index);
+    m_y.remove(index);
+    if (!m_inTension.isEmpty()) {
+        m_inTension.remove(index);
+        m_outTension.remove(index);
+        m_tangentX.remove(index);
+        m_tangentY.remove(index);
+    }
+}
+
+void VertexStore::assign(const QVector<PolylineVertex>& vertices)
+{
+    int n = vertices.size();
+    clear();
+    m_x.resize(n);
+    m_y.resize(n);
+    m_smooth.resize(n);
+
+    bool defaultCurveData = true;
+    for (int i = 0; i < n; ++i) {
+        const PolylineVertex& vertex = vertices[i];
+        m_x[i] = vertex.position.x();
+        m_y[i] = vertex.position.y();
+        if (vertex.type == VertexType::Smooth) {
+            m_smooth.setBit(i);
+            ++m_smoothCount;
+        }
+        defaultCurveData = defaultCurveData && hasDefaultCurveData(vertex);
+    }
+
+    if (!defaultCurveData) {
+        ensureCurveData();
+        for (int i = 0; i < n; ++i) {
+            setCurveData(i, vertices[i]);
+        }
+    }
+}
+
+QVector<PolylineVertex> VertexStore::toVector() const
+{
+    QVector<PolylineVertex> vertices;
+    vertices.reserve(size());
+    for (int i = 0; i < size(); ++i) {
+        vertices.append(at(i));
+    }
+    return vertices;
+}
+
+QPolygonF VertexStore::positions() const
+{
+    int n = size();
+    QPolygonF polygon(n);
+    const double* x = m_x.constData();
+    const double* y = m_y.constData();
+    for (int i = 0; i < n; ++i) {
+        polygon[i] = QPointF(x[i], y[i]);
+    }
+    return polygon;
+}
+
+QRectF VertexStore::bounds() const
+{
+    int n = size();
+    if (n == 0) {
+        return QRectF();
+    }
+
+    const double* x = m_x.constData();
+    const double* y = m_y.constData();
+    double minX = x[0];
+    double maxX = x[0];
+    double minY = y[0];
+    double maxY = y[0];
+    for (int i = 1; i < n; ++i) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+double VertexStore::signedArea() const
+{
+    int n = size();
+    if (n < 3) {
+        return 0.0;
+    }
+
+    const double* x = m_x.constData();
+    const double* y = m_y.constData();
+    double area = x[n - 1] * y[0] - x[0] * y[n - 1];
+    for (int i = 0; i < n - 1; ++i) {
+        area += x[i] * y[i + 1] - x[i + 1] * y[i];
+    }
+    return area / 2.0;
+}
+
+QVector<double> VertexStore::chordLengths(bool closed) const
+{
+    int n = size();
+    int count = (n < 2) ? 0 : (closed ? n : n - 1);
+    QVector<double> lengths(count);
+
+    const double* x = m_x.constData();
+    const double* y = m_y.constData();
+    for (int i = 0; i < count; ++i) {
+        int next = (i + 1 == n) ? 0 : i + 1;
+        double dx = x[next] - x[i];
+        double dy = y[next] - y[i];
+        lengths[i] = std::sqrt(dx * dx + dy * dy);
+    }
+    return lengths;
+}
+
+void VertexStore::translate(double dx, double dy)
+{
+    int n = size();
+    double* x = m_x.data();
+    double* y = m_y.data();
+    for (int i = 0; i < n; ++i) {
+        x[i] += dx;
+        y[i] += dy;
+    }
+}
+
+void VertexStore::transform(const QTransform& matrix)
+{
+    // Coefficients are hoisted out of the loops so each vertex costs a few
+    // multiply-adds, with no trigonometry or axis normalization
+    const double m11 = matrix.m11();
+    const double m12 = matrix.m12();
+    const double m21 = matrix.m21();
+    const double m22 = matrix.m22();
+    const double dx = matrix.dx();
+    const double dy = matrix.dy();
+
+    int n = size();
+    double* x = m_x.data();
+    double* y = m_y.data();
+    for (int i = 0; i < n; ++i) {
+        const double px = x[i];
+        const double py = y[i];
+        x[i] = m11 * px + m21 * py + dx;
+        y[i] = m12 * px + m22 * py + dy;
+    }
+
+    // Without explicit tangents there is nothing else to map
+    if (m_tangentX.isEmpty()) {
+        return;
+    }
+
+    // Rotations, mirrors and uniform scales change every length by the same
+    // factor, which is divided out once; anything else needs a per-vertex
+    // renormalization. A zero tangent (none set) stays zero.
+    double scaleX = std::sqrt(m11 * m11 + m12 * m12);
+    double scaleY = std::sqrt(m21 * m21 + m22 * m22);
+    double tolerance = 1e-12 * std::max(scaleX, scaleY);
+    bool conformal = scaleX > 0.0 && std::abs(scaleX - scaleY) <= tolerance &&
+                     std::abs(m11 * m21 + m12 * m22) <= tolerance * std::max(scaleX, scaleY);
+
+    double* tx = m_tangentX.data();
+    double* ty = m_tangentY.data();
+    if (conformal) {
+        const double t11 = m11 / scaleX;
+        const double t12 = m12 / scaleX;
+        const double t21 = m21 / scaleX;
+        const double t22 = m22 / scaleX;
+        for (int i = 0; i < n; ++i) {
+            const double u = tx[i];
+            const double v = ty[i];
+            tx[i] = t11 * u + t21 * v;
+            ty[i] = t12 * u + t22 * v;
+        }
+    } else {
+        for (int i = 0; i < n; ++i) {
+            const double u = tx[i];
+            const double v = ty[i];
+            const double mappedX = m11 * u + m21 * v;
+            const double mappedY = m12 * u + m22 * v;
+            const double mappedLength = std::sqrt(mappedX * mappedX + mappedY * mappedY);
+            if (mappedLength > 0.0) {
+                const double factor = std::sqrt(u * u + v * v) / mappedLength;
+                tx[i] = mappedX * factor;
+                ty[i] = mappedY * factor;
+            }
+        }
+    }
+}
+
+bool VertexStore::hasDefaultCurveData(const PolylineVertex& vertex)
+{
+    return vertex.incomingTension == DefaultTension &&
+           vertex.outgoingTension == DefaultTension &&
+           vertex.tangent == QPointF();
+}
+
+void VertexStore::ensureCurveData()
+{
+    if (m_inTension.isEmpty() && !m_x.isEmpty()) {
+        m_inTension.fill(DefaultTension, size());
+        m_outTension.fill(DefaultTension, size());
+        m_tangentX.fill(0.0, size());
+        m_tangentY.fill(0.0, size());
+    }
+}
+
+void VertexStore::setCurveData(int index, const PolylineVertex& vertex)
+{
+    if (m_inTension.isEmpty()) {
+        if (hasDefaultCurveData(vertex)) {
+            return;
+        }
+        ensureCurveData();
+    }
+    m_inTension[index] = vertex.incomingTension;
+    m_outTension[index] = vertex.outgoingTension;
+    m_tangentX[index] = vertex.tangent.x();
+    m_tangentY[index] = vertex.tangent.y();
+}
+
+} // namespace Geometry
+} // namespace PatternCAD
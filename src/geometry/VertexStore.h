@@ -0,0 +1,148 @@
+/**
+ * VertexStore.h
+ *
+ * Structure-of-arrays storage for polyline vertices
+ */
+
+#ifndef PATTERNCAD_VERTEXSTORE_H
+#define PATTERNCAD_VERTEXSTORE_H
+
+#include <QBitArray>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+#include <QTransform>
+#include <QVector>
+
+namespace PatternCAD {
+namespace Geometry {
+
+/**
+ * Vertex type for polyline
+ */
+enum class VertexType {
+    Sharp,   // Point pointu (coin)
+    Smooth   // Point courbe (tangente continue)
+};
+
+/**
+ * Vertex in a polyline with position and type
+ */
+struct PolylineVertex {
+    QPointF position;
+    VertexType type;
+    double incomingTension;  // For smooth vertices: tension for incoming handle
+    double outgoingTension;  // For smooth vertices: tension for outgoing handle
+    QPointF tangent;         // For smooth vertices: direction of the tangent (outgoing)
+
+    PolylineVertex(const QPointF& pos = QPointF(), VertexType t = VertexType::Sharp,
+                   double inTens = 0.5, double outTens = 0.5, const QPointF& tang = QPointF())
+        : position(pos), type(t), incomingTension(inTens), outgoingTension(outTens), tangent(tang) {}
+
+    // Legacy constructor for backward compatibility
+    PolylineVertex(const QPointF& pos, VertexType t, double tens, const QPointF& tang)
+        : position(pos), type(t), incomingTension(tens), outgoingTension(tens), tangent(tang) {}
+};
+
+/**
+ * VertexStore keeps polyline vertices as separate arrays rather than
+ * PolylineVertex structs:
+ * - Contiguous x and y coordinate arrays, so position-only loops (bounds,
+ *   chord lengths, area, transforms) touch nothing else and vectorize
+ * - Vertex types as a packed bitset
+ * - Tensions and tangents in their own arrays, allocated only once a
+ *   vertex departs from the defaults (0.5 tensions, no tangent); pieces
+ *   with only sharp, default vertices (e.g. scanned outlines) store two
+ *   doubles and a bit per vertex
+ * Vertices are read and written as PolylineVertex values.
+ */
+class VertexStore
+{
+public:
+    static constexpr double DefaultTension = 0.5;
+
+    // Forward iteration yielding PolylineVertex values
+    class const_iterator
+    {
+    public:
+        const_iterator(const VertexStore* store, int index) : m_store(store), m_index(index) {}
+        PolylineVertex operator*() const { return m_store->at(m_index); }
+        const_iterator& operator++() { ++m_index; return *this; }
+        bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const VertexStore* m_store;
+        int m_index;
+    };
+
+    VertexStore();
+    explicit VertexStore(const QVector<PolylineVertex>& vertices);
+
+    int size() const { return m_x.size(); }
+    bool isEmpty() const { return m_x.isEmpty(); }
+    void clear();
+    void reserve(int size);
+
+    // Element access; whole vertices are assembled from the arrays
+    PolylineVertex at(int index) const;
+    PolylineVertex operator[](int index) const { return at(index); }
+    PolylineVertex first() const { return at(0); }
+    PolylineVertex last() const { return at(size() - 1); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    QPointF position(int index) const { return QPointF(m_x[index], m_y[index]); }
+    VertexType type(int index) const { return m_smooth.testBit(index) ? VertexType::Smooth : VertexType::Sharp; }
+    bool isSmooth(int index) const { return m_smooth.testBit(index); }
+    int smoothCount() const { return m_smoothCount; }
+    double incomingTension(int index) const { return m_inTension.isEmpty() ? DefaultTension : m_inTension[index]; }
+    double outgoingTension(int index) const { return m_outTension.isEmpty() ? DefaultTension : m_outTension[index]; }
+    QPointF tangent(int index) const {
+        return m_tangentX.isEmpty() ? QPointF() : QPointF(m_tangentX[index], m_tangentY[index]);
+    }
+
+    // Modification
+    void set(int index, const PolylineVertex& vertex);
+    void setPosition(int index, const QPointF& position) { m_x[index] = position.x(); m_y[index] = position.y(); }
+    void setType(int index, VertexType type);
+    void append(const PolylineVertex& vertex);
+    void insert(int index, const PolylineVertex& vertex);
+    void remove(int index);
+
+    // Conversion to and from interleaved vertices
+    void assign(const QVector<PolylineVertex>& vertices);
+    QVector<PolylineVertex> toVector() const;
+    QPolygonF positions() const;
+
+    // Kernels over the coordinate arrays
+    QRectF bounds() const;                    // Of the vertex positions
+    double signedArea() const;                // Shoelace area of the vertex polygon
+    QVector<double> chordLengths(bool closed) const;  // Straight distance of each edge
+    void translate(double dx, double dy);
+
+    // Affine part of the matrix on positions; tangents follow the linear
+    // part and keep their length
+    void transform(const QTransform& matrix);
+
+private:
+    static bool hasDefaultCurveData(const PolylineVertex& vertex);
+    void ensureCurveData();
+    void setCurveData(int index, const PolylineVertex& vertex);
+
+    QVector<double> m_x;
+    QVector<double> m_y;
+    QBitArray m_smooth;
+    int m_smoothCount;
+
+    // Empty while every vertex has the default tensions and no tangent
+    QVector<double> m_inTension;
+    QVector<double> m_outTension;
+    QVector<double> m_tangentX;
+    QVector<double> m_tangentY;
+};
+
+} // namespace Geometry
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_VERTEXSTORE_H
@@ -334,7 +334,7 @@ bool DXFFormat::parseDXF(QTextStream& stream, Document* document)
         processEntity(currentEntity, document);
     }
 
-    qDebug() << "DXF: Parse complete. Document has" << document->objects().size() << "objects";
+    qDebug() << "DXF: Parse complete. Document has" << document->objectCount() << "objects";
     qDebug() << "DXF: Layers:" << document->layers();
 
     return true;
@@ -412,7 +412,7 @@ void DXFFormat::processPolyline(const DXFEntity& polylineEntity, const QList<DXF
 
     document->addObjectDirect(polyline);
     qDebug() << "DXF: POLYLINE added with" << polylineVertices.size() << "vertices, closed:" << closed
-             << "layer:" << layerName << "document now has" << document->objects().size() << "objects";
+             << "layer:" << layerName << "document now has" << document->objectCount() << "objects";
 }
 
 void DXFFormat::processLine(const DXFEntity& entity, Document* document)
@@ -433,7 +433,7 @@ void DXFFormat::processLine(const DXFEntity& entity, Document* document)
     line->setLayer(layerName);
 
     document->addObjectDirect(line);
-    qDebug() << "DXF: LINE added, document now has" << document->objects().size() << "objects";
+    qDebug() << "DXF: LINE added, document now has" << document->objectCount() << "objects";
 }
 
 void DXFFormat::processCircle(const DXFEntity& entity, Document* document)
@@ -725,118 +725,10 @@ void DXFFormat::writePolyline(QTextStream& stream, const Geometry::GeometryObjec
     const auto* polyline = dynamic_cast<const Geometry::Polyline*>(obj);
     if (!polyline) return;
 
-    QVector<Geometry::PolylineVertex> vertices = polyline->vertices();
-    if (vertices.isEmpty()) return;
-
-    int n = vertices.size();
-
-    // Check if polyline has any curves
-    bool hasCurves = false;
-    for (const auto& vertex : vertices) {
-        if (vertex.type == Geometry::VertexType::Smooth) {
-            hasCurves = true;
-            break;
-        }
-    }
-
-    // If no curves, use simple LWPOLYLINE
-    if (!hasCurves) {
-        writePair(stream, 0, "LWPOLYLINE");
-        writePair(stream, 8, obj->layer());
-        writePair(stream, 90, static_cast<int>(vertices.size()));
-        writePair(stream, 70, polyline->isClosed() ? 1 : 0);
-
-        for (const auto& vertex : vertices) {
-            writePair(stream, 10, vertex.position.x());
-            writePair(stream, 20, vertex.position.y());
-        }
-
-        // Export notches as separate geometry
-        for (Notch* notch : polyline->notches()) {
-            writeNotch(stream, notch, obj->layer());
-        }
-
-        // Export match points as separate geometry
-        for (MatchPoint* mp : polyline->matchPoints()) {
-            writeMatchPoint(stream, mp, obj->layer());
-        }
-        return;
-    }
-
-    // For polylines with curves, approximate curves with many segments for smooth appearance
-    QList<QPointF> allPoints;
-
-    for (int i = 0; i < n; ++i) {
-        int nextIdx = (i + 1) % n;
-
-        // If we're at the last vertex and not closed, add it and stop
-        if (!polyline->isClosed() && i == n - 1) {
-            allPoints.append(vertices[i].position);
-            break;
-        }
-
-        const Geometry::PolylineVertex& current = vertices[i];
-        const Geometry::PolylineVertex& next = vertices[nextIdx];
-
-        // Add current vertex
-        allPoints.append(current.position);
-
-        // Check if segment is curved
-        bool needsCurve = (current.type == Geometry::VertexType::Smooth) ||
-                          (next.type == Geometry::VertexType::Smooth);
-
-        if (needsCurve) {
-            QPointF p1 = current.position;
-            QPointF p2 = next.position;
-
-            // Distance between points for scaling control points
-            QPointF segment = p2 - p1;
-            double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-            double controlDistance = dist / 3.0;
-
-            // Calculate control points for cubic Bezier
-            QPointF c1, c2;
-
-            // Determine control point c1 (outgoing from current)
-            if (current.type == Geometry::VertexType::Smooth && current.tangent != QPointF()) {
-                c1 = p1 + current.tangent * controlDistance * current.outgoingTension;
-            } else if (current.type == Geometry::VertexType::Smooth) {
-                int prevIdx = (i - 1 + n) % n;
-                QPointF p0 = vertices[prevIdx].position;
-                if (!polyline->isClosed() && i == 0) p0 = p1;
-                c1 = p1 + (p2 - p0) * (current.outgoingTension / 3.0);
-            } else {
-                c1 = p1 + (p2 - p1) * 0.01;
-            }
-
-            // Determine control point c2 (incoming to next)
-            if (next.type == Geometry::VertexType::Smooth && next.tangent != QPointF()) {
-                c2 = p2 - next.tangent * controlDistance * next.incomingTension;
-            } else if (next.type == Geometry::VertexType::Smooth) {
-                int nextNextIdx = (i + 2) % n;
-                QPointF p3 = vertices[nextNextIdx].position;
-                if (!polyline->isClosed() && nextIdx == n - 1) p3 = p2;
-                c2 = p2 - (p3 - p1) * (next.incomingTension / 3.0);
-            } else {
-                c2 = p2 - (p2 - p1) * 0.01;
-            }
-
-            // Approximate cubic Bezier with many segments for smooth appearance (50 segments)
-            const int segments = 50;
-            for (int j = 1; j < segments; ++j) {
-                double t = static_cast<double>(j) / segments;
-                double t2 = t * t;
-                double t3 = t2 * t;
-                double mt = 1.0 - t;
-                double mt2 = mt * mt;
-                double mt3 = mt2 * mt;
-
-                QPointF point = p1 * mt3 + c1 * 3.0 * mt2 * t + c2 * 3.0 * mt * t2 + p2 * t3;
-                allPoints.append(point);
-            }
-        }
-        // If segment is straight (both sharp), next vertex will be added in next iteration
-    }
+    // Curves flattened to the export tolerance (the cached outline is reused
+    // when it already matches)
+    QPolygonF allPoints = polyline->flattenedOutline(flatteningTolerance());
+    if (allPoints.isEmpty()) return;
 
     // Write as LWPOLYLINE with all points
     writePair(stream, 0, "LWPOLYLINE");
@@ -862,7 +754,7 @@ void DXFFormat::writePolyline(QTextStream& stream, const Geometry::GeometryObjec
     // Export seam allowance as separate LWPOLYLINE
     SeamAllowance* seam = polyline->seamAllowance();
     if (seam && seam->isEnabled()) {
-        QVector<QVector<QPointF>> allOffsets = seam->computeAllOffsets();
+        const QVector<QVector<QPointF>>& allOffsets = seam->computeAllOffsets(flatteningTolerance());
         for (const QVector<QPointF>& offsetPoints : allOffsets) {
             if (offsetPoints.size() < 2) continue;
             
@@ -13,6 +13,7 @@ namespace IO {
 
 FileFormat::FileFormat(QObject* parent)
     : QObject(parent)
+    , m_flatteningTolerance(-1.0)
 {
 }
 
@@ -32,6 +33,16 @@ bool FileFormat::canExport() const
     return (caps & static_cast<int>(FormatCapability::Export)) != 0;
 }
 
+double FileFormat::flatteningTolerance() const
+{
+    return m_flatteningTolerance;
+}
+
+void FileFormat::setFlatteningTolerance(double tolerance)
+{
+    m_flatteningTolerance = tolerance;
+}
+
 QString FileFormat::fileFilter() const
 {
     QStringList extensions = fileExtensions();
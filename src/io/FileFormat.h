@@ -76,6 +76,11 @@ public:
     virtual bool importProject(const QString& filepath, Project* project);
     virtual bool exportProject(const QString& filepath, const Project* project);
 
+    // Chord tolerance (mm) used to flatten curves on export; values <= 0
+    // use the on-screen default
+    double flatteningTolerance() const;
+    void setFlatteningTolerance(double tolerance);
+
     // Error handling
     QString lastError() const;
     bool hasError() const;
@@ -90,6 +95,7 @@ protected:
     void reportProgress(int percentage);
 
     QString m_lastError;
+    double m_flatteningTolerance;
 };
 
 } // namespace IO
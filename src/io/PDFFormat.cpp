@@ -161,59 +161,12 @@ void PDFFormat::renderGeometry(QPainter* painter, const Geometry::GeometryObject
         painter->drawRect(QRectF(rect->topLeft(), QSizeF(rect->width(), rect->height())));
     }
     else if (auto* polyline = dynamic_cast<const Geometry::Polyline*>(object)) {
-        // Polyline with bezier curves
-        const QVector<Geometry::PolylineVertex>& vertices = polyline->vertices();
-        if (vertices.isEmpty()) {
+        // Polyline with bezier curves, drawn from the polyline's cached path
+        const QPainterPath& path = polyline->path();
+        if (path.isEmpty()) {
             return;
         }
 
-        QPainterPath path;
-        const Geometry::PolylineVertex& first = vertices.first();
-        path.moveTo(first.position);
-
-        for (int i = 1; i < vertices.size(); ++i) {
-            const Geometry::PolylineVertex& prev = vertices[i - 1];
-            const Geometry::PolylineVertex& curr = vertices[i];
-
-            if (prev.type == Geometry::VertexType::Smooth || curr.type == Geometry::VertexType::Smooth) {
-                // Cubic bezier
-                QPointF p1 = prev.position;
-                QPointF p2 = curr.position;
-
-                // Calculate control points - same algorithm as Polyline::createPath()
-                QPointF segment = p2 - p1;
-                double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-                double controlDistance = dist / 3.0;
-
-                QPointF c1, c2;
-
-                // Control point c1 (outgoing from prev)
-                if (prev.type == Geometry::VertexType::Smooth && prev.tangent != QPointF()) {
-                    c1 = p1 + prev.tangent * controlDistance * prev.outgoingTension;
-                } else {
-                    // Sharp: place control point very close to p1
-                    c1 = p1 + (p2 - p1) * 0.01;
-                }
-
-                // Control point c2 (incoming to curr)
-                if (curr.type == Geometry::VertexType::Smooth && curr.tangent != QPointF()) {
-                    c2 = p2 - curr.tangent * controlDistance * curr.incomingTension;
-                } else {
-                    // Sharp: place control point very close to p2
-                    c2 = p2 - (p2 - p1) * 0.01;
-                }
-
-                path.cubicTo(c1, c2, p2);
-            } else {
-                // Straight line
-                path.lineTo(curr.position);
-            }
-        }
-
-        if (polyline->isClosed()) {
-            path.closeSubpath();
-        }
-
         painter->drawPath(path);
         
         // Save current pen for restoration
@@ -278,7 +231,7 @@ void PDFFormat::renderGeometry(QPainter* painter, const Geometry::GeometryObject
             seamPen.setStyle(Qt::DashLine);
             painter->setPen(seamPen);
             
-            QVector<QVector<QPointF>> allOffsets = seam->computeAllOffsets();
+            const QVector<QVector<QPointF>>& allOffsets = seam->computeAllOffsets(flatteningTolerance());
             for (const QVector<QPointF>& offsetPoints : allOffsets) {
                 if (offsetPoints.size() < 2) continue;
                 
@@ -21,6 +21,7 @@
 #include <QDateTime>
 #include <QDomDocument>
 #include <QRegularExpression>
+#include <QPainterPath>
 #include <cmath>
 
 namespace PatternCAD {
@@ -576,59 +577,29 @@ QString SVGFormat::geometryToSVG(const Geometry::GeometryObject* object, int ind
                .arg(style);
     }
     else if (auto* polyline = dynamic_cast<const Geometry::Polyline*>(object)) {
-        // Polyline as path
-        const QVector<Geometry::PolylineVertex>& vertices = polyline->vertices();
-        if (vertices.isEmpty()) {
+        // Polyline as path, built from the polyline's cached outline path
+        const QPainterPath& path = polyline->path();
+        if (path.isEmpty()) {
             return "";
         }
 
         QString pathData;
         QTextStream pathStream(&pathData);
 
-        // Start point
-        const Geometry::PolylineVertex& first = vertices.first();
-        pathStream << QString("M %1,%2").arg(first.position.x()).arg(first.position.y());
-
-        // Build path with cubic bezier curves
-        for (int i = 1; i < vertices.size(); ++i) {
-            const Geometry::PolylineVertex& prev = vertices[i - 1];
-            const Geometry::PolylineVertex& curr = vertices[i];
-
-            if (prev.type == Geometry::VertexType::Smooth || curr.type == Geometry::VertexType::Smooth) {
-                // Use cubic bezier - same algorithm as Polyline::createPath()
-                QPointF p1 = prev.position;
-                QPointF p2 = curr.position;
-
-                // Calculate control points
-                QPointF segment = p2 - p1;
-                double dist = std::sqrt(segment.x() * segment.x() + segment.y() * segment.y());
-                double controlDistance = dist / 3.0;
-
-                QPointF c1, c2;
-
-                // Control point c1 (outgoing from prev)
-                if (prev.type == Geometry::VertexType::Smooth && prev.tangent != QPointF()) {
-                    c1 = p1 + prev.tangent * controlDistance * prev.outgoingTension;
-                } else {
-                    // Sharp: place control point very close to p1
-                    c1 = p1 + (p2 - p1) * 0.01;
-                }
-
-                // Control point c2 (incoming to curr)
-                if (curr.type == Geometry::VertexType::Smooth && curr.tangent != QPointF()) {
-                    c2 = p2 - curr.tangent * controlDistance * curr.incomingTension;
-                } else {
-                    // Sharp: place control point very close to p2
-                    c2 = p2 - (p2 - p1) * 0.01;
-                }
-
+        for (int i = 0; i < path.elementCount(); ++i) {
+            const QPainterPath::Element& e = path.elementAt(i);
+            if (e.isMoveTo()) {
+                pathStream << QString("M %1,%2").arg(e.x).arg(e.y);
+            } else if (e.isLineTo()) {
+                pathStream << QString(" L %1,%2").arg(e.x).arg(e.y);
+            } else if (e.isCurveTo() && i + 2 < path.elementCount()) {
+                const QPainterPath::Element& c2 = path.elementAt(i + 1);
+                const QPainterPath::Element& end = path.elementAt(i + 2);
                 pathStream << QString(" C %1,%2 %3,%4 %5,%6")
-                              .arg(c1.x()).arg(c1.y())
-                              .arg(c2.x()).arg(c2.y())
-                              .arg(p2.x()).arg(p2.y());
-            } else {
-                // Straight line
-                pathStream << QString(" L %1,%2").arg(curr.position.x()).arg(curr.position.y());
+                              .arg(e.x).arg(e.y)
+                              .arg(c2.x).arg(c2.y)
+                              .arg(end.x).arg(end.y);
+                i += 2;
             }
         }
 
@@ -654,7 +625,7 @@ QString SVGFormat::geometryToSVG(const Geometry::GeometryObject* object, int ind
         // Export seam allowance
         SeamAllowance* seam = polyline->seamAllowance();
         if (seam && seam->isEnabled()) {
-            QVector<QVector<QPointF>> allOffsets = seam->computeAllOffsets();
+            const QVector<QVector<QPointF>>& allOffsets = seam->computeAllOffsets(flatteningTolerance());
             for (const QVector<QPointF>& offsetPoints : allOffsets) {
                 if (offsetPoints.size() < 2) continue;
                 
@@ -10,6 +10,9 @@
 #include "geometry/GeometryObject.h"
 #include "geometry/Line.h"
 #include "geometry/Polyline.h"
+#include "geometry/Notch.h"
+#include "geometry/MatchPoint.h"
+#include "core/Units.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <cmath>
@@ -147,10 +150,15 @@ void AddPointOnContourTool::mouseMoveEvent(QMouseEvent* event)
                     m_hasProjection = true;
                     showStatusMessage(QString("Click to add point on line"));
                 } else if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_hoveredObject)) {
-                    int segmentIdx = polyline->findClosestSegment(m_currentPoint, &m_projectedPoint);
+                    double tParam = 0.0;
+                    int segmentIdx = polyline->findClosestSegmentWithT(m_currentPoint, &m_projectedPoint, &tParam);
                     m_hasProjection = (segmentIdx >= 0);
                     if (m_hasProjection) {
-                        showStatusMessage(QString("Click to add point on polyline (segment %1)").arg(segmentIdx + 1));
+                        double fraction = polyline->segment(segmentIdx).fractionAtParameter(tParam);
+                        double distance = polyline->distanceAlongContour(segmentIdx, fraction);
+                        showStatusMessage(QString("Click to add point on polyline (segment %1, %2 along contour)")
+                                          .arg(segmentIdx + 1)
+                                          .arg(Units::formatLength(distance, 1)));
                     }
                 }
             } else {
@@ -243,8 +251,8 @@ Geometry::GeometryObject* AddPointOnContourTool::findLineOrPolylineAt(const QPoi
 
     const double tolerance = 10.0;
 
-    // Search in reverse order (top to bottom)
-    auto objects = m_document->objects();
+    // Search candidates near the point in reverse order (top to bottom)
+    auto objects = m_document->objectsAt(point, tolerance);
     for (int i = objects.size() - 1; i >= 0; --i) {
         Geometry::GeometryObject* obj = objects[i];
 
@@ -295,10 +303,63 @@ void AddPointOnContourTool::addPointToPolyline(Geometry::Polyline* polyline, con
     int segmentIdx = polyline->findClosestSegment(point);
 
     if (segmentIdx >= 0) {
+        // Remember how far along the split segment each notch/match point sits
+        QVector<QPair<Notch*, double>> splitNotches;
+        QVector<QPair<MatchPoint*, double>> splitMatchPoints;
+        double segmentStart = polyline->distanceAlongContour(segmentIdx, 0.0);
+        for (Notch* notch : polyline->notches()) {
+            if (notch->segmentIndex() == segmentIdx) {
+                splitNotches.append({notch, polyline->distanceAlongContour(segmentIdx, notch->position()) - segmentStart});
+            }
+        }
+        for (MatchPoint* mp : polyline->matchPoints()) {
+            if (mp->isOnEdge() && mp->segmentIndex() == segmentIdx) {
+                splitMatchPoints.append({mp, polyline->distanceAlongContour(segmentIdx, mp->segmentPosition()) - segmentStart});
+            }
+        }
+
         // Insert new vertex after the segment start
         Geometry::PolylineVertex newVertex(point, Geometry::VertexType::Sharp);
         polyline->insertVertex(segmentIdx + 1, newVertex);
 
+        // Keep markers attached: later segments shift by one, markers on the
+        // split segment are relocated by their distance along it
+        for (Notch* notch : polyline->notches()) {
+            if (notch->segmentIndex() > segmentIdx) {
+                notch->setSegmentIndex(notch->segmentIndex() + 1);
+            }
+        }
+        for (MatchPoint* mp : polyline->matchPoints()) {
+            if (mp->isOnEdge() && mp->segmentIndex() > segmentIdx) {
+                mp->setSegmentIndex(mp->segmentIndex() + 1);
+            }
+        }
+        double firstHalf = polyline->calculateSegmentLength(segmentIdx);
+        double secondHalf = polyline->calculateSegmentLength(segmentIdx + 1);
+        auto relocate = [&](double offset, int* segment, double* fraction) {
+            if (offset <= firstHalf || secondHalf <= 1e-10) {
+                *segment = segmentIdx;
+                *fraction = (firstHalf > 1e-10) ? qMin(1.0, offset / firstHalf) : 0.0;
+            } else {
+                *segment = segmentIdx + 1;
+                *fraction = qMin(1.0, (offset - firstHalf) / secondHalf);
+            }
+        };
+        for (const auto& entry : splitNotches) {
+            int segment = segmentIdx;
+            double fraction = 0.0;
+            relocate(entry.second, &segment, &fraction);
+            entry.first->setSegmentIndex(segment);
+            entry.first->setPosition(fraction);
+        }
+        for (const auto& entry : splitMatchPoints) {
+            int segment = segmentIdx;
+            double fraction = 0.0;
+            relocate(entry.second, &segment, &fraction);
+            entry.first->setSegmentIndex(segment);
+            entry.first->setSegmentPosition(fraction);
+        }
+
         // Select the newly added vertex
         m_selectedVertexObject = polyline;
         m_selectedVertexIndex = segmentIdx + 1;
@@ -353,7 +414,7 @@ void AddPointOnContourTool::drawVertexHandles(QPainter* painter, Geometry::Geome
     const double hoveredHandleSize = 8.0;
 
     if (auto* polyline = dynamic_cast<Geometry::Polyline*>(obj)) {
-        auto vertices = polyline->vertices();
+        const auto& vertices = polyline->vertices();
         for (int i = 0; i < vertices.size(); ++i) {
             QPointF pos = vertices[i].position;
             bool isHovered = (m_hoveredVertexIndex == i && m_hoveredObject == obj);
@@ -429,9 +490,8 @@ void AddPointOnContourTool::toggleVertexType()
     }
 
     if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-        auto vertices = polyline->vertices();
-        if (m_selectedVertexIndex >= 0 && m_selectedVertexIndex < vertices.size()) {
-            Geometry::PolylineVertex vertex = vertices[m_selectedVertexIndex];
+        if (m_selectedVertexIndex >= 0 && m_selectedVertexIndex < polyline->vertexCount()) {
+            Geometry::PolylineVertex vertex = polyline->vertexAt(m_selectedVertexIndex);
 
             // Toggle type
             if (vertex.type == Geometry::VertexType::Sharp) {
@@ -443,8 +503,7 @@ void AddPointOnContourTool::toggleVertexType()
             }
 
             // Update the vertex
-            vertices[m_selectedVertexIndex] = vertex;
-            polyline->setVertices(vertices);
+            polyline->editVertices().setVertex(m_selectedVertexIndex, vertex);
         }
     } else {
         showStatusMessage("Type toggle only works on polylines");
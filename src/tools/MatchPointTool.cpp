@@ -188,11 +188,7 @@ void MatchPointTool::mouseMoveEvent(QMouseEvent* event)
         
         if (m_hoveredPolyline && m_hoveredSegment >= 0) {
             // Calculate hover point on edge
-            auto vertices = m_hoveredPolyline->vertices();
-            int nextIdx = (m_hoveredSegment + 1) % vertices.size();
-            QPointF p1 = vertices[m_hoveredSegment].position;
-            QPointF p2 = vertices[nextIdx].position;
-            m_hoveredPoint = p1 + (p2 - p1) * m_hoveredPosition;
+            m_hoveredPoint = m_hoveredPolyline->segmentPointAt(m_hoveredSegment, m_hoveredPosition);
             m_mode = Mode::PreviewPlace;
         } else {
             m_mode = Mode::Idle;
@@ -290,39 +286,24 @@ Geometry::Polyline* MatchPointTool::findPolylineAt(const QPointF& point, int* se
     double closestPosition = 0.0;
     double closestDistance = tolerance;
 
-    const auto& objects = m_document->objects();
+    const auto objects = m_document->objectsAt(point, tolerance);
 
     for (int i = objects.size() - 1; i >= 0; --i) {
         Geometry::GeometryObject* obj = objects[i];
 
         if (auto* polyline = qobject_cast<Geometry::Polyline*>(obj)) {
-            QPointF closestPoint;
-            int seg = polyline->findClosestSegment(point, &closestPoint);
-
-            if (seg >= 0) {
-                QPointF delta = point - closestPoint;
-                double distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-
-                if (distance < closestDistance) {
-                    closestDistance = distance;
-                    closestPolyline = polyline;
-                    closestSegment = seg;
-
-                    auto vertices = polyline->vertices();
-                    int nextIdx = (seg + 1) % vertices.size();
-                    QPointF p1 = vertices[seg].position;
-                    QPointF p2 = vertices[nextIdx].position;
-                    QPointF segVec = p2 - p1;
-                    double segLength = std::sqrt(segVec.x() * segVec.x() + segVec.y() * segVec.y());
-                    
-                    if (segLength > 0.0001) {
-                        QPointF toPoint = closestPoint - p1;
-                        closestPosition = std::sqrt(toPoint.x() * toPoint.x() + toPoint.y() * toPoint.y()) / segLength;
-                        closestPosition = std::max(0.0, std::min(1.0, closestPosition));
-                    } else {
-                        closestPosition = 0.0;
-                    }
-                }
+            // Segments farther than the best hit so far are culled by the
+            // polyline's index without being evaluated
+            double tParam = 0.0;
+            double distance = 0.0;
+            int seg = polyline->findSegmentAt(point, closestDistance, nullptr, &tParam, &distance);
+
+            if (seg >= 0 && distance < closestDistance) {
+                closestDistance = distance;
+                closestPolyline = polyline;
+                closestSegment = seg;
+                // Store the position as an arc-length fraction of the segment
+                closestPosition = polyline->segment(seg).fractionAtParameter(tParam);
             }
         }
     }
@@ -339,7 +320,7 @@ MatchPoint* MatchPointTool::findMatchPointAt(const QPointF& point, Geometry::Pol
 
     const double tolerance = 12.0;
 
-    const auto& objects = m_document->objects();
+    const auto objects = m_document->objectsAt(point, tolerance);
 
     for (int i = objects.size() - 1; i >= 0; --i) {
         Geometry::GeometryObject* obj = objects[i];
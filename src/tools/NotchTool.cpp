@@ -161,11 +161,7 @@ void NotchTool::mouseMoveEvent(QMouseEvent* event)
         
         if (m_hoveredPolyline && m_hoveredSegment >= 0) {
             // Calculate hover point on edge
-            auto vertices = m_hoveredPolyline->vertices();
-            int nextIdx = (m_hoveredSegment + 1) % vertices.size();
-            QPointF p1 = vertices[m_hoveredSegment].position;
-            QPointF p2 = vertices[nextIdx].position;
-            m_hoveredPoint = p1 + (p2 - p1) * m_hoveredPosition;
+            m_hoveredPoint = m_hoveredPolyline->segmentPointAt(m_hoveredSegment, m_hoveredPosition);
             m_mode = Mode::PreviewPlace;
         } else {
             m_mode = Mode::Idle;
@@ -267,27 +263,24 @@ Geometry::Polyline* NotchTool::findPolylineAt(const QPointF& point, int* segment
     double closestPosition = 0.0;
     double closestDistance = tolerance;
 
-    const auto& objects = m_document->objects();
+    const auto objects = m_document->objectsAt(point, tolerance);
 
     for (int i = objects.size() - 1; i >= 0; --i) {
         Geometry::GeometryObject* obj = objects[i];
 
         if (auto* polyline = qobject_cast<Geometry::Polyline*>(obj)) {
-            QPointF closestPoint;
+            // Segments farther than the best hit so far are culled by the
+            // polyline's index without being evaluated
             double tParam = 0.0;
-            int seg = polyline->findClosestSegmentWithT(point, &closestPoint, &tParam);
-
-            if (seg >= 0) {
-                QPointF delta = point - closestPoint;
-                double distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-
-                if (distance < closestDistance) {
-                    closestDistance = distance;
-                    closestPolyline = polyline;
-                    closestSegment = seg;
-                    // Use the correct curve parameter directly
-                    closestPosition = tParam;
-                }
+            double distance = 0.0;
+            int seg = polyline->findSegmentAt(point, closestDistance, nullptr, &tParam, &distance);
+
+            if (seg >= 0 && distance < closestDistance) {
+                closestDistance = distance;
+                closestPolyline = polyline;
+                closestSegment = seg;
+                // Store the position as an arc-length fraction of the segment
+                closestPosition = polyline->segment(seg).fractionAtParameter(tParam);
             }
         }
     }
@@ -304,7 +297,7 @@ Notch* NotchTool::findNotchAt(const QPointF& point, Geometry::Polyline** polylin
 
     const double tolerance = 10.0;  // pixels
 
-    const auto& objects = m_document->objects();
+    const auto objects = m_document->objectsAt(point, tolerance);
 
     for (int i = objects.size() - 1; i >= 0; --i) {
         Geometry::GeometryObject* obj = objects[i];
@@ -412,16 +405,8 @@ void NotchTool::drawPreviewNotch(QPainter* painter) const
     if (!m_hoveredPolyline || m_hoveredSegment < 0) return;
 
     // Calculate position and normal
-    auto vertices = m_hoveredPolyline->vertices();
-    int nextIdx = (m_hoveredSegment + 1) % vertices.size();
-    QPointF p1 = vertices[m_hoveredSegment].position;
-    QPointF p2 = vertices[nextIdx].position;
-    
-    QPointF position = p1 + (p2 - p1) * m_hoveredPosition;
-    QPointF tangent = p2 - p1;
-    double len = std::sqrt(tangent.x() * tangent.x() + tangent.y() * tangent.y());
-    if (len < 0.0001) return;
-    tangent /= len;
+    QPointF position = m_hoveredPolyline->segmentPointAt(m_hoveredSegment, m_hoveredPosition);
+    QPointF tangent = m_hoveredPolyline->segmentTangentAt(m_hoveredSegment, m_hoveredPosition);
     QPointF normal(-tangent.y(), tangent.x());
 
     // Draw preview with transparency
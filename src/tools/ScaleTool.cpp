@@ -353,6 +353,7 @@ void ScaleTool::executeScale()
     // Create scale command
     auto* command = new ScaleObjectsCommand(selectedObjects, m_scaleX, m_scaleY, m_scaleOrigin);
 
+    Document::ChangeBatch batch(m_document);
     if (m_document->undoStack()) {
         m_document->undoStack()->push(command);
     } else {
@@ -206,7 +206,7 @@ Geometry::Polyline* SeamAllowanceTool::findPolylineAt(const QPointF& point) cons
 {
     if (!m_document) return nullptr;
 
-    const auto& objects = m_document->objects();
+    const auto objects = m_document->objectsAt(point);
 
     // Search in reverse order (top to bottom)
     for (int i = objects.size() - 1; i >= 0; --i) {
@@ -228,7 +228,7 @@ int SeamAllowanceTool::findVertexAt(Geometry::Polyline* polyline, const QPointF&
     if (!polyline) return -1;
 
     const double tolerance = 8.0;  // 8 pixels tolerance for vertex selection
-    const QVector<Geometry::PolylineVertex>& vertices = polyline->vertices();
+    const Geometry::VertexStore& vertices = polyline->vertices();
 
     for (int i = 0; i < vertices.size(); ++i) {
         QPointF delta = point - vertices[i].position;
@@ -357,7 +357,7 @@ void SeamAllowanceTool::drawVertexHighlights(QPainter* painter) const
 {
     if (!m_selectedPolyline) return;
 
-    const QVector<Geometry::PolylineVertex>& vertices = m_selectedPolyline->vertices();
+    const Geometry::VertexStore& vertices = m_selectedPolyline->vertices();
     const double vertexRadius = 6.0;
 
     for (int i = 0; i < vertices.size(); ++i) {
@@ -394,7 +394,7 @@ void SeamAllowanceTool::drawRangePreview(QPainter* painter) const
     if (!m_selectedPolyline || m_startVertexIndex < 0 || m_hoveredVertexIndex < 0) return;
     if (m_hoveredVertexIndex == m_startVertexIndex) return;  // Don't preview same vertex
 
-    const QVector<Geometry::PolylineVertex>& vertices = m_selectedPolyline->vertices();
+    const Geometry::VertexStore& vertices = m_selectedPolyline->vertices();
     int n = vertices.size();
 
     // Draw edges from start to hovered (clockwise) in green
@@ -129,7 +129,7 @@ void SelectTool::mousePressEvent(QMouseEvent* event)
 
                 // Save initial tangent and tension for undo
                 if (auto* polyline = dynamic_cast<Geometry::Polyline*>(handleObject)) {
-                    auto vertices = polyline->vertices();
+                    const auto& vertices = polyline->vertices();
                     m_handleStartTangent = vertices[handleVertexIndex].tangent;
                     // Store the tension for the side we're dragging
                     m_handleStartTension = (handleSide < 0)
@@ -231,7 +231,9 @@ void SelectTool::mouseMoveEvent(QMouseEvent* event)
     if (m_mode == SelectMode::DraggingHandle) {
         // Move curve handle and update tangent
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedHandleObject)) {
-            auto vertices = polyline->vertices();
+            // Edits below (including the tension search) emit a single changed()
+            auto edit = polyline->editVertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
 
             if (m_selectedHandleVertexIndex >= 0 && m_selectedHandleVertexIndex < n) {
@@ -362,8 +364,7 @@ void SelectTool::mouseMoveEvent(QMouseEvent* event)
                             } else {
                                 vertex.outgoingTension = testTension;
                             }
-                            vertices[m_selectedHandleVertexIndex] = vertex;
-                            polyline->setVertices(vertices);
+                            edit.setVertex(m_selectedHandleVertexIndex, vertex);
 
                             // Calculate resulting length
                             double currentLength = polyline->calculateSegmentLength(affectedSegment);
@@ -402,8 +403,8 @@ void SelectTool::mouseMoveEvent(QMouseEvent* event)
                         }
                     }
 
-                    vertices[m_selectedHandleVertexIndex] = vertex;
-                    polyline->setVertices(vertices);
+                    edit.setVertex(m_selectedHandleVertexIndex, vertex);
+                    edit.commit();
 
                     if (m_canvas) {
                         m_canvas->viewport()->update();
@@ -418,7 +419,7 @@ void SelectTool::mouseMoveEvent(QMouseEvent* event)
         // Apply length constraint if active
         if (m_constrainedSegmentIndex >= 0) {
             if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-                auto vertices = polyline->vertices();
+                const auto& vertices = polyline->vertices();
                 int n = vertices.size();
 
                 // Determine which endpoint of the constrained segment is the vertex being moved
@@ -599,7 +600,7 @@ void SelectTool::mouseReleaseEvent(QMouseEvent* event)
         // Finish handle drag - create undo command
         if (m_document && m_selectedHandleObject) {
             if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedHandleObject)) {
-                auto vertices = polyline->vertices();
+                const auto& vertices = polyline->vertices();
                 if (m_selectedHandleVertexIndex >= 0 && m_selectedHandleVertexIndex < vertices.size()) {
                     QPointF newTangent = vertices[m_selectedHandleVertexIndex].tangent;
                     // Get the tension for the side we were dragging
@@ -716,8 +717,7 @@ void SelectTool::keyPressEvent(QKeyEvent* event)
                 return;
             }
 
-            // Clear previous selection and select this object
-            m_document->clearSelection();
+            // Replace the selection with this object
             QList<Geometry::GeometryObject*> selected;
             selected.append(m_hoveredObject);
             m_document->setSelectedObjects(selected);
@@ -840,15 +840,15 @@ void SelectTool::keyPressEvent(QKeyEvent* event)
             // Cancel handle drag - restore original values
             if (m_selectedHandleObject) {
                 if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedHandleObject)) {
-                    auto vertices = polyline->vertices();
-                    if (m_selectedHandleVertexIndex >= 0 && m_selectedHandleVertexIndex < vertices.size()) {
-                        vertices[m_selectedHandleVertexIndex].tangent = m_handleStartTangent;
+                    if (m_selectedHandleVertexIndex >= 0 && m_selectedHandleVertexIndex < polyline->vertexCount()) {
+                        Geometry::PolylineVertex vertex = polyline->vertexAt(m_selectedHandleVertexIndex);
+                        vertex.tangent = m_handleStartTangent;
                         if (m_selectedHandleSide < 0) {
-                            vertices[m_selectedHandleVertexIndex].incomingTension = m_handleStartTension;
+                            vertex.incomingTension = m_handleStartTension;
                         } else {
-                            vertices[m_selectedHandleVertexIndex].outgoingTension = m_handleStartTension;
+                            vertex.outgoingTension = m_handleStartTension;
                         }
-                        polyline->setVertices(vertices);
+                        polyline->editVertices().setVertex(m_selectedHandleVertexIndex, vertex);
                         if (m_canvas) {
                             m_canvas->viewport()->update();
                         }
@@ -932,7 +932,7 @@ void SelectTool::keyPressEvent(QKeyEvent* event)
         }
 
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(targetObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
             int prevSegmentIdx = (targetIndex - 1 + n) % n;
             int nextSegmentIdx = targetIndex;
@@ -974,7 +974,7 @@ void SelectTool::keyPressEvent(QKeyEvent* event)
         // Request dimension input for free segment if one is locked
         if (m_constrainedSegmentIndex >= 0 && m_selectedVertexObject) {
             if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-                auto vertices = polyline->vertices();
+                const auto& vertices = polyline->vertices();
                 int n = vertices.size();
                 int prevSegmentIdx = (m_selectedVertexIndex - 1 + n) % n;
                 int nextSegmentIdx = m_selectedVertexIndex;
@@ -1024,7 +1024,7 @@ void SelectTool::keyPressEvent(QKeyEvent* event)
             double currentLength = polyline->calculateSegmentLength(m_selectedSegmentIndex);
 
             // Calculate angle of segment
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
             int endIdx = (m_selectedSegmentIndex + 1) % n;
 
@@ -1112,7 +1112,7 @@ void SelectTool::drawOverlay(QPainter* painter)
         auto selected = m_document->selectedObjects();
         for (auto* obj : selected) {
             // Skip if object's layer is not visible
-            if (!m_document->isLayerVisible(obj->layer())) {
+            if (!m_document->isLayerVisible(m_document->objectLayerId(obj))) {
                 continue;
             }
 
@@ -1133,7 +1133,7 @@ void SelectTool::drawOverlay(QPainter* painter)
         }
 
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             if (m_selectedVertexIndex >= 0 && m_selectedVertexIndex < vertices.size()) {
                 if (vertices[m_selectedVertexIndex].type == Geometry::VertexType::Smooth) {
                     drawCurveHandles(painter, m_selectedVertexObject, m_selectedVertexIndex);
@@ -1244,7 +1244,7 @@ void SelectTool::drawOverlay(QPainter* painter)
         }
 
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedSegmentObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
 
             if (m_selectedSegmentIndex < n) {
@@ -1306,7 +1306,7 @@ void SelectTool::drawOverlay(QPainter* painter)
     // Draw locked segment indicator (even when not dragging)
     if (m_constrainedSegmentIndex >= 0 && m_selectedVertexObject) {
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
 
             if (m_constrainedSegmentIndex < n) {
@@ -1411,7 +1411,7 @@ void SelectTool::drawOverlay(QPainter* painter)
         painter->setFont(dimFont);
 
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
 
             // Show dimensions of adjacent segments
@@ -1569,15 +1569,13 @@ void SelectTool::selectObjectAt(const QPointF& point, bool addToSelection)
     }
 
     if (obj) {
-        QList<Geometry::GeometryObject*> selected = m_document->selectedObjects();
-        if (selected.contains(obj) && addToSelection) {
+        if (addToSelection && m_document->isSelected(obj)) {
             // Deselect if already selected
-            selected.removeAll(obj);
+            m_document->deselect(QList<Geometry::GeometryObject*>() << obj);
         } else {
             // Add to selection
-            selected.append(obj);
+            m_document->select(QList<Geometry::GeometryObject*>() << obj);
         }
-        m_document->setSelectedObjects(selected);
     }
 }
 
@@ -1593,19 +1591,17 @@ void SelectTool::selectObjectsInRect(const QRectF& rect, bool addToSelection)
 
     QList<Geometry::GeometryObject*> objects = findObjectsInRect(rect);
     if (!objects.isEmpty()) {
-        QList<Geometry::GeometryObject*> selected = m_document->selectedObjects();
+        QList<Geometry::GeometryObject*> selectable;
         int lockedCount = 0;
         for (auto* obj : objects) {
             // Skip objects on locked layers
-            if (m_document->isLayerLocked(obj->layer())) {
+            if (m_document->isLayerLocked(m_document->objectLayerId(obj))) {
                 lockedCount++;
                 continue;
             }
-            if (!selected.contains(obj)) {
-                selected.append(obj);
-            }
+            selectable.append(obj);
         }
-        m_document->setSelectedObjects(selected);
+        m_document->select(selectable);
         if (lockedCount > 0) {
             showStatusMessage(QString("Skipped %1 object(s) on locked layers").arg(lockedCount));
         }
@@ -1623,7 +1619,8 @@ void SelectTool::updateMove(const QPointF& delta)
         return;
     }
 
-    // Apply delta to selected objects
+    // Apply delta to selected objects, reported as one change
+    Document::ChangeBatch batch(m_document);
     for (auto* obj : m_document->selectedObjects()) {
         obj->translate(delta);
     }
@@ -1640,8 +1637,10 @@ Geometry::GeometryObject* SelectTool::findObjectAt(const QPointF& point) const
         return nullptr;
     }
 
-    // Search in reverse order (top to bottom)
-    auto objects = m_document->objects();
+    // Only objects whose bounds are within hit reach of the point, in
+    // reverse order (top to bottom); contains() accepts points outside the
+    // bounds of lines, circles and points
+    auto objects = m_document->objectsAt(point, Geometry::GeometryObject::MaxHitTolerance);
     for (int i = objects.size() - 1; i >= 0; --i) {
         if (objects[i]->contains(point)) {
             return objects[i];
@@ -1659,13 +1658,7 @@ QList<Geometry::GeometryObject*> SelectTool::findObjectsInRect(const QRectF& rec
         return result;
     }
 
-    for (auto* obj : m_document->objects()) {
-        if (rect.intersects(obj->boundingRect())) {
-            result.append(obj);
-        }
-    }
-
-    return result;
+    return m_document->objectsInRect(rect);
 }
 
 void SelectTool::showContextMenu(const QPoint& globalPos)
@@ -1738,6 +1731,7 @@ void SelectTool::showContextMenu(const QPoint& globalPos)
         if (ok && !newLayer.isEmpty()) {
             // Use command for undo/redo support
             ChangeLayersCommand* cmd = new ChangeLayersCommand(selected, newLayer);
+            Document::ChangeBatch batch(m_document);
             m_document->undoStack()->push(cmd);
 
             showStatusMessage(QString("Moved %1 object(s) to layer '%2'")
@@ -1812,7 +1806,7 @@ void SelectTool::drawVertexHandles(QPainter* painter, Geometry::GeometryObject*
     const double hoveredHandleSize = 8.0;
 
     if (auto* polyline = dynamic_cast<Geometry::Polyline*>(obj)) {
-        auto vertices = polyline->vertices();
+        const auto& vertices = polyline->vertices();
         for (int i = 0; i < vertices.size(); ++i) {
             QPointF pos = vertices[i].position;
             bool isHovered = (m_hoveredVertexIndex == i);
@@ -1900,7 +1894,7 @@ void SelectTool::applyFreeSegmentLength(double lengthInMm, double angleDegrees)
         return;
     }
 
-    auto vertices = polyline->vertices();
+    const auto& vertices = polyline->vertices();
     int n = vertices.size();
     int prevSegmentIdx = (m_selectedVertexIndex - 1 + n) % n;
     int nextSegmentIdx = m_selectedVertexIndex;
@@ -2037,23 +2031,15 @@ int SelectTool::findSegmentAt(const QPointF& point, Geometry::GeometryObject** o
 
     const double tolerance = 5.0; // pixels
 
-    // Check all objects in document
-    for (auto* obj : m_document->objects()) {
+    // Check objects whose bounds are within reach
+    for (auto* obj : m_document->objectsAt(point, tolerance)) {
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(obj)) {
-            int segmentIndex = polyline->findClosestSegment(point);
+            int segmentIndex = polyline->findSegmentAt(point, tolerance);
             if (segmentIndex >= 0) {
-                // Check if we're actually close enough to the segment
-                QPointF closestPoint;
-                polyline->findClosestSegment(point, &closestPoint);
-                QPointF delta = point - closestPoint;
-                double dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-
-                if (dist <= tolerance) {
-                    if (outObject) {
-                        *outObject = obj;
-                    }
-                    return segmentIndex;
+                if (outObject) {
+                    *outObject = obj;
                 }
+                return segmentIndex;
             }
         } else if (auto* line = dynamic_cast<Geometry::Line*>(obj)) {
             // For a line, there's only one segment (index 0)
@@ -2099,7 +2085,7 @@ void SelectTool::applySegmentLength(double lengthInMm, double angleDegrees, UI::
         return;
     }
 
-    auto vertices = polyline->vertices();
+    const auto& vertices = polyline->vertices();
     int n = vertices.size();
 
     if (m_selectedSegmentIndex < 0 || m_selectedSegmentIndex >= n) {
@@ -2191,75 +2177,6 @@ void SelectTool::applySegmentLength(double lengthInMm, double angleDegrees, UI::
         .arg(modeStr));
 }
 
-QPointF SelectTool::getHandlePosition(Geometry::Polyline* polyline, int vertexIndex, int side) const
-{
-    auto vertices = polyline->vertices();
-    int n = vertices.size();
-
-    if (vertexIndex < 0 || vertexIndex >= n) {
-        return QPointF();
-    }
-
-    const Geometry::PolylineVertex& vertex = vertices[vertexIndex];
-
-    // Only smooth vertices have handles
-    if (vertex.type != Geometry::VertexType::Smooth) {
-        return QPointF();
-    }
-
-    QPointF vertexPos = vertex.position;
-
-    // If explicit tangent is set, use it
-    if (vertex.tangent != QPointF()) {
-        QPointF tangent = vertex.tangent;
-        // Normalize
-        double len = std::sqrt(tangent.x() * tangent.x() + tangent.y() * tangent.y());
-        if (len > 0.001) {
-            tangent /= len;
-        }
-
-        // Calculate handle distance based on neighbors
-        int prevIdx = (vertexIndex - 1 + n) % n;
-        int nextIdx = (vertexIndex + 1) % n;
-        QPointF p0 = vertices[prevIdx].position;
-        QPointF p2 = vertices[nextIdx].position;
-        double dist = std::sqrt((p2 - p0).x() * (p2 - p0).x() + (p2 - p0).y() * (p2 - p0).y());
-
-        if (side < 0) {
-            // Incoming handle (opposite direction)
-            double handleDist = (dist / 6.0) * vertex.incomingTension;
-            return vertexPos - tangent * handleDist;
-        } else {
-            // Outgoing handle
-            double handleDist = (dist / 6.0) * vertex.outgoingTension;
-            return vertexPos + tangent * handleDist;
-        }
-    } else {
-        // Use Catmull-Rom default
-        int prevIdx = (vertexIndex - 1 + n) % n;
-        int nextIdx = (vertexIndex + 1) % n;
-        QPointF p0 = vertices[prevIdx].position;
-        QPointF p2 = vertices[nextIdx].position;
-
-        if (!polyline->isClosed() && vertexIndex == 0) p0 = vertexPos;
-        if (!polyline->isClosed() && vertexIndex == n - 1) p2 = vertexPos;
-
-        QPointF tangent = (p2 - p0);
-        double len = std::sqrt(tangent.x() * tangent.x() + tangent.y() * tangent.y());
-        if (len > 0.001) {
-            tangent /= len;
-        }
-
-        if (side < 0) {
-            double handleDist = (len / 6.0) * vertex.incomingTension;
-            return vertexPos - tangent * handleDist;
-        } else {
-            double handleDist = (len / 6.0) * vertex.outgoingTension;
-            return vertexPos + tangent * handleDist;
-        }
-    }
-}
-
 int SelectTool::findHandleAt(const QPointF& point, Geometry::GeometryObject** outObject, int* outSide) const
 {
     if (!m_document) {
@@ -2271,11 +2188,11 @@ int SelectTool::findHandleAt(const QPointF& point, Geometry::GeometryObject** ou
     // Check selected or hovered vertices first
     if (m_selectedVertexObject) {
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(m_selectedVertexObject)) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             if (m_selectedVertexIndex >= 0 && m_selectedVertexIndex < vertices.size()) {
                 if (vertices[m_selectedVertexIndex].type == Geometry::VertexType::Smooth) {
                     // Check incoming handle
-                    QPointF handlePos = getHandlePosition(polyline, m_selectedVertexIndex, -1);
+                    QPointF handlePos = polyline->handlePosition(m_selectedVertexIndex, -1);
                     QPointF delta = point - handlePos;
                     double dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
                     if (dist <= tolerance) {
@@ -2285,7 +2202,7 @@ int SelectTool::findHandleAt(const QPointF& point, Geometry::GeometryObject** ou
                     }
 
                     // Check outgoing handle
-                    handlePos = getHandlePosition(polyline, m_selectedVertexIndex, +1);
+                    handlePos = polyline->handlePosition(m_selectedVertexIndex, +1);
                     delta = point - handlePos;
                     dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
                     if (dist <= tolerance) {
@@ -2299,31 +2216,16 @@ int SelectTool::findHandleAt(const QPointF& point, Geometry::GeometryObject** ou
     }
 
     // Check all objects for handles near hovered smooth vertices
+    // (handles can lie outside an object's bounds, so each polyline's
+    // handle index is queried)
     for (auto* obj : m_document->objects()) {
         if (auto* polyline = dynamic_cast<Geometry::Polyline*>(obj)) {
-            auto vertices = polyline->vertices();
-            for (int i = 0; i < vertices.size(); ++i) {
-                if (vertices[i].type == Geometry::VertexType::Smooth) {
-                    // Check incoming handle
-                    QPointF handlePos = getHandlePosition(polyline, i, -1);
-                    QPointF delta = point - handlePos;
-                    double dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-                    if (dist <= tolerance) {
-                        if (outObject) *outObject = obj;
-                        if (outSide) *outSide = -1;
-                        return i;
-                    }
-
-                    // Check outgoing handle
-                    handlePos = getHandlePosition(polyline, i, +1);
-                    delta = point - handlePos;
-                    dist = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-                    if (dist <= tolerance) {
-                        if (outObject) *outObject = obj;
-                        if (outSide) *outSide = +1;
-                        return i;
-                    }
-                }
+            int side = 0;
+            int vertexIndex = polyline->findHandleAt(point, tolerance, &side);
+            if (vertexIndex >= 0) {
+                if (outObject) *outObject = obj;
+                if (outSide) *outSide = side;
+                return vertexIndex;
             }
         }
     }
@@ -2336,7 +2238,7 @@ void SelectTool::drawCurveHandles(QPainter* painter, Geometry::GeometryObject* o
     auto* polyline = dynamic_cast<Geometry::Polyline*>(obj);
     if (!polyline) return;
 
-    auto vertices = polyline->vertices();
+    const auto& vertices = polyline->vertices();
     if (vertexIndex < 0 || vertexIndex >= vertices.size()) return;
 
     const Geometry::PolylineVertex& vertex = vertices[vertexIndex];
@@ -2345,8 +2247,8 @@ void SelectTool::drawCurveHandles(QPainter* painter, Geometry::GeometryObject* o
     QPointF vertexPos = vertex.position;
 
     // Get handle positions
-    QPointF inHandle = getHandlePosition(polyline, vertexIndex, -1);
-    QPointF outHandle = getHandlePosition(polyline, vertexIndex, +1);
+    QPointF inHandle = polyline->handlePosition(vertexIndex, -1);
+    QPointF outHandle = polyline->handlePosition(vertexIndex, +1);
 
     painter->save();
 
@@ -2422,7 +2324,7 @@ void SelectTool::lockSelectedSegments()
             m_lockedLengths[key] = length;
 
             // Store segment positions
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
             QPointF start = vertices[key.segmentIndex].position;
             QPointF end = vertices[(key.segmentIndex + 1) % n].position;
@@ -2496,7 +2398,7 @@ void SelectTool::drawSelectedSegments(QPainter* painter) const
     for (const auto& key : m_selectedSegments) {
         Geometry::Polyline* polyline = dynamic_cast<Geometry::Polyline*>(key.object);
         if (polyline) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
             int i = key.segmentIndex;
             int nextIdx = (i + 1) % n;
@@ -2569,7 +2471,7 @@ void SelectTool::drawLockedSegments(QPainter* painter) const
     for (const auto& key : m_lockedSegments) {
         Geometry::Polyline* polyline = dynamic_cast<Geometry::Polyline*>(key.object);
         if (polyline) {
-            auto vertices = polyline->vertices();
+            const auto& vertices = polyline->vertices();
             int n = vertices.size();
             int i = key.segmentIndex;
             int nextIdx = (i + 1) % n;
@@ -2659,7 +2561,7 @@ QPointF SelectTool::constrainVertexWithLockedSegments(const QPointF& newPos, Geo
 {
     if (!polyline) return newPos;
 
-    auto vertices = polyline->vertices();
+    const auto& vertices = polyline->vertices();
     int n = vertices.size();
     int prevSegment = (vertexIndex - 1 + n) % n;
     int nextSegment = vertexIndex;
@@ -161,7 +161,6 @@ private:
     // Curve handle manipulation
     int findHandleAt(const QPointF& point, Geometry::GeometryObject** outObject, int* outSide) const;
     void drawCurveHandles(QPainter* painter, Geometry::GeometryObject* obj, int vertexIndex) const;
-    QPointF getHandlePosition(Geometry::Polyline* polyline, int vertexIndex, int side) const;
 
     // Multi-segment lock helpers
     void toggleSegmentSelection(Geometry::GeometryObject* obj, int segmentIdx);
@@ -7,19 +7,44 @@
 #include "Canvas.h"
 #include "DimensionRenderer.h"
 #include "core/Document.h"
+#include "core/SettingsManager.h"
 #include "core/Units.h"
 #include "tools/Tool.h"
 #include "geometry/GeometryObject.h"
+#include "geometry/Polyline.h"
+#include "geometry/SeamAllowance.h"
 #include <QPainter>
 #include <QScrollBar>
 #include <QMenu>
 #include <QContextMenuEvent>
+#include <QResizeEvent>
 #include <QDebug>
+#include <QPicture>
+#include <QFontMetrics>
+#include <QPair>
+#include <algorithm>
 #include <cmath>
 
 namespace PatternCAD {
 namespace UI {
 
+namespace {
+    // Idle time after the last gesture event before the full-quality pass
+    const int InteractionIdleMs = 150;
+
+    // Live objects are drawn this many times coarser while interacting
+    // (one level of detail up)
+    const double InteractiveLodFactor = 4.0;
+
+    // Radius of self-intersection markers, in scene units
+    const double SelfIntersectionMarkRadius = 4.0;
+
+    // Tile images kept per visible tile: the view itself, the neighbouring
+    // zoom level's tiles standing in as placeholders, and a panning margin
+    const int TileCacheHeadroom = 3;
+    const int MinCachedTiles = 256;
+}
+
 Canvas::Canvas(QWidget* parent)
     : QGraphicsView(parent)
     , m_scene(nullptr)
@@ -29,7 +54,14 @@ Canvas::Canvas(QWidget* parent)
     , m_zoomLevel(1.0)
     , m_gridVisible(true)
     , m_snapToGrid(true)
+    , m_gridColor(SettingsManager::instance().editor().gridColor)
+    , m_gridLinesSpacing(0.0)
     , m_isPanning(false)
+    , m_interacting(false)
+    , m_nextPaintOrder(0)
+    , m_lastTileScale(0.0)
+    , m_renderStatsVisible(false)
+    , m_selfIntersectionsVisible(true)
 {
     setupScene();
 
@@ -44,12 +76,31 @@ Canvas::Canvas(QWidget* parent)
     // Enable keyboard focus so Canvas receives key events
     setFocusPolicy(Qt::StrongFocus);
 
+    // Grid color follows preferences
+    connect(&SettingsManager::instance(), &SettingsManager::editorSettingsChanged, this, [this]() {
+        QColor gridColor = SettingsManager::instance().editor().gridColor;
+        if (gridColor != m_gridColor) {
+            m_gridColor = gridColor;
+            viewport()->update();
+        }
+    });
+
+    // Full-quality pass once gestures pause
+    m_interactionTimer.setSingleShot(true);
+    m_interactionTimer.setInterval(InteractionIdleMs);
+    connect(&m_interactionTimer, &QTimer::timeout, this, &Canvas::endInteraction);
+
     // TODO: Configure view settings
     // TODO: Connect signals
 }
 
 Canvas::~Canvas()
 {
+    // Tile jobs report back to this canvas; drop queued ones and let
+    // running ones finish first
+    m_tilePool.clear();
+    m_tilePool.waitForDone();
+
     // Cleanup
     if (m_scene) {
         delete m_scene;
@@ -78,25 +129,45 @@ Document* Canvas::document() const
 
 void Canvas::setDocument(Document* document)
 {
+    if (m_document) {
+        m_document->disconnect(this);
+    }
     m_document = document;
+    rebuildPaintIndex();
 
     if (m_document) {
-        // Connect document signals to trigger redraws
-        connect(m_document, &Document::objectAdded, this, [this]() {
-            viewport()->update();
+        // Connect document signals to repaint only the affected areas
+        connect(m_document, &Document::objectAdded, this, [this](Geometry::GeometryObject* object) {
+            addToPaintIndex(object);
         });
-        connect(m_document, &Document::objectRemoved, this, [this]() {
-            viewport()->update();
+        connect(m_document, &Document::objectRemoved, this, [this](Geometry::GeometryObject* object) {
+            removeFromPaintIndex(object);
         });
-        connect(m_document, &Document::objectChanged, this, [this]() {
-            viewport()->update();
+        connect(m_document, &Document::objectsChanged, this, [this](const QList<Geometry::GeometryObject*>& objects) {
+            updatePaintEntries(objects);
+        });
+        connect(m_document, &Document::objectsSelected, this, &Canvas::updatePaintEntries);
+        connect(m_document, &Document::objectsDeselected, this, &Canvas::updatePaintEntries);
+        connect(m_document, &Document::layerAdded, this, &Canvas::updateTileCapacity);
+        connect(m_document, &Document::layerRenamed, this, [this](const QString& oldName, const QString&) {
+            m_tileCache.invalidateLayer(oldName);
+            m_extraTileLayers.remove(oldName);
+        });
+        connect(m_document, &Document::layerRemoved, this, [this](const QString& layerName) {
+            m_tileCache.invalidateLayer(layerName);
+            m_extraTileLayers.remove(layerName);
+            updateTileCapacity();
         });
         connect(m_document, &Document::layerVisibilityChanged, this, [this](const QString& layerName, bool visible) {
-            qDebug() << "Canvas: layerVisibilityChanged received - layer:" << layerName << "visible:" << visible;
+            PATTERNCAD_RENDER_LOG() << "Canvas: layerVisibilityChanged received - layer:" << layerName << "visible:" << visible;
+            // Also emitted for color changes, which the tiles and display
+            // lists bake in
+            clearDisplayLists(layerName);
+            m_tileCache.invalidateLayer(layerName);
+            updateTileCapacity();
             // Force full repaint when layer visibility changes
             scene()->invalidate();
             update();
-            qDebug() << "Canvas: update() called";
         });
     }
 }
@@ -118,16 +189,8 @@ void Canvas::zoomFit()
         return;
     }
 
-    // Calculate bounding rect of all objects
-    QRectF bounds;
-    for (auto* obj : m_document->objects()) {
-        QRectF objBounds = obj->boundingRect();
-        if (bounds.isNull()) {
-            bounds = objBounds;
-        } else {
-            bounds = bounds.united(objBounds);
-        }
-    }
+    // Bounding rect of all objects (root of the document's spatial index)
+    QRectF bounds = m_document->objectsBounds();
 
     // If no objects or empty bounds, use a default view centered at origin
     if (bounds.isNull() || bounds.isEmpty()) {
@@ -209,6 +272,7 @@ void Canvas::setZoomLevel(double level)
         double scaleFactor = level / m_zoomLevel;
         scale(scaleFactor, scaleFactor);
         m_zoomLevel = level;
+        updateTileCapacity();
         emit zoomChanged(m_zoomLevel);
     }
 }
@@ -279,6 +343,38 @@ Tools::Tool* Canvas::activeTool() const
     return m_activeTool;
 }
 
+RenderStats& Canvas::renderStats()
+{
+    return m_renderStats;
+}
+
+bool Canvas::renderStatsVisible() const
+{
+    return m_renderStatsVisible;
+}
+
+void Canvas::setRenderStatsVisible(bool visible)
+{
+    if (m_renderStatsVisible != visible) {
+        m_renderStatsVisible = visible;
+        m_renderStats.setEnabled(visible);
+        viewport()->update();
+    }
+}
+
+bool Canvas::selfIntersectionsVisible() const
+{
+    return m_selfIntersectionsVisible;
+}
+
+void Canvas::setSelfIntersectionsVisible(bool visible)
+{
+    if (m_selfIntersectionsVisible != visible) {
+        m_selfIntersectionsVisible = visible;
+        viewport()->update();
+    }
+}
+
 bool Canvas::event(QEvent* event)
 {
     // Intercept Tab key before Qt's focus system consumes it
@@ -300,6 +396,7 @@ void Canvas::wheelEvent(QWheelEvent* event)
     // Use factor 1.1 for smoother, more controlled zoom
     double delta = event->angleDelta().y() / 120.0;
     double factor = std::pow(1.1, delta);
+    beginInteraction();
     setZoomLevel(m_zoomLevel * factor);
     event->accept();
 }
@@ -333,6 +430,7 @@ void Canvas::mouseMoveEvent(QMouseEvent* event)
 
     // Handle panning
     if (m_isPanning) {
+        beginInteraction();
         QPoint delta = event->pos() - m_panStartPos;
         horizontalScrollBar()->setValue(horizontalScrollBar()->value() - delta.x());
         verticalScrollBar()->setValue(verticalScrollBar()->value() - delta.y());
@@ -342,6 +440,10 @@ void Canvas::mouseMoveEvent(QMouseEvent* event)
     }
 
     if (m_activeTool) {
+        // Dragging with a button held is a gesture; plain hovering is not
+        if (event->buttons() != Qt::NoButton) {
+            beginInteraction();
+        }
         m_activeTool->mouseMoveEvent(event);
         viewport()->update(); // Update to show tool preview
     }
@@ -455,61 +557,546 @@ void Canvas::contextMenuEvent(QContextMenuEvent* event)
     menu.exec(event->globalPos());
 }
 
+void Canvas::paintEvent(QPaintEvent* event)
+{
+    m_renderStats.beginFrame();
+    QGraphicsView::paintEvent(event);
+    m_renderStats.endFrame();
+}
+
+void Canvas::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent(event);
+    updateTileCapacity();
+}
+
 void Canvas::drawBackground(QPainter* painter, const QRectF& rect)
 {
-    // Draw white background
-    painter->fillRect(rect, Qt::white);
+    {
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::BackgroundPhase);
+        // Draw white background
+        painter->fillRect(rect, Qt::white);
+    }
 
     // Draw grid if visible
     if (m_gridVisible) {
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::GridPhase);
         drawGrid(painter, rect);
     }
 
     // Draw origin indicator
+    RenderStats::ScopedTimer timer(m_renderStats, RenderStats::BackgroundPhase);
     drawOriginIndicator(painter);
 }
 
 void Canvas::drawForeground(QPainter* painter, const QRectF& rect)
 {
-    Q_UNUSED(rect);
-
     if (!m_document) {
+        drawRenderStats(painter);
         return;
     }
 
-    // Render all document objects that are on visible layers
-    painter->setRenderHint(QPainter::Antialiasing);
-    int drawnCount = 0;
-    int skippedCount = 0;
-    for (Geometry::GeometryObject* obj : m_document->objects()) {
-        if (obj) {
-            bool visible = m_document->isLayerVisible(obj->layer());
-            if (visible) {
-                QColor layerColor = m_document->layerColor(obj->layer());
-                obj->draw(painter, layerColor);
-                drawnCount++;
+    // Committed geometry comes from the tile cache
+    {
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::TilesPhase);
+        drawTiles(painter, rect);
+    }
+
+    // Live objects whose painted extent meets the exposed area are drawn on top
+    QList<Geometry::GeometryObject*> liveObjects;
+    {
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::GeometryPhase);
+        QList<Geometry::GeometryObject*> candidates = objectsToPaint(rect);
+        QList<Geometry::GeometryObject*> visibleObjects;
+        QList<Geometry::GeometryObject*> bakingObjects;
+        m_renderStats.count(RenderStats::OutsideView, static_cast<int>(m_paintEntries.size() - candidates.size()));
+        for (Geometry::GeometryObject* obj : candidates) {
+            bool layerVisible = m_document->isLayerVisible(m_document->objectLayerId(obj));
+            if (layerVisible) {
+                visibleObjects.append(obj);
+            }
+            PaintEntry entry = m_paintEntries.value(obj);
+            if (!entry.live) {
+                // Objects just baked into tiles are drawn directly until
+                // the stale tiles they are missing from are replaced
+                if (layerVisible && m_tileCache.hasStale(entry.layer, transform().m11(), entry.bounds & rect)) {
+                    bakingObjects.append(obj);
+                }
+                continue;
+            }
+            if (layerVisible) {
+                liveObjects.append(obj);
             } else {
-                skippedCount++;
+                m_renderStats.countCulled(obj->type());
             }
         }
-    }
-    if (skippedCount > 0) {
-        qDebug() << "Canvas::drawForeground - drawn:" << drawnCount << "skipped:" << skippedCount;
+
+        // Level of detail follows the zoom, one level coarser while interacting
+        painter->setRenderHint(QPainter::Antialiasing, !m_interacting);
+        double scale = transform().m11();
+        if (m_interacting) {
+            scale /= InteractiveLodFactor;
+        }
+        for (Geometry::GeometryObject* obj : bakingObjects + liveObjects) {
+            obj->drawAtScale(painter, m_document->layerColor(m_document->objectLayerId(obj)), scale);
+            m_renderStats.countDrawn(obj->type());
+        }
+
+        // Over tiles and live drawing alike
+        drawSelfIntersections(painter, visibleObjects);
     }
 
     // Render dimensions for selected objects
     if (m_dimensionRenderer) {
-        for (Geometry::GeometryObject* obj : m_document->objects()) {
-            if (obj && m_document->isLayerVisible(obj->layer())) {
-                m_dimensionRenderer->renderDimensions(painter, obj);
-            }
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::DimensionsPhase);
+        for (Geometry::GeometryObject* obj : liveObjects) {
+            m_dimensionRenderer->renderDimensions(painter, obj);
         }
     }
 
     // Let active tool draw preview/overlay
     if (m_activeTool) {
+        RenderStats::ScopedTimer timer(m_renderStats, RenderStats::ToolOverlayPhase);
         m_activeTool->drawOverlay(painter);
     }
+
+    drawRenderStats(painter);
+}
+
+QRectF Canvas::objectPaintRect(Geometry::GeometryObject* object) const
+{
+    QRectF rect = object->paintBounds();
+    if (m_dimensionRenderer) {
+        rect |= m_dimensionRenderer->annotationBounds(object);
+    }
+    return rect;
+}
+
+void Canvas::rebuildPaintIndex()
+{
+    m_paintIndex.clear();
+    m_paintEntries.clear();
+    m_nextPaintOrder = 0;
+    m_tileCache.clear();
+    m_extraTileLayers.clear();
+
+    if (m_document) {
+        for (Geometry::GeometryObject* obj : m_document->objects()) {
+            addToPaintIndex(obj);
+        }
+    }
+    viewport()->update();
+}
+
+void Canvas::addToPaintIndex(Geometry::GeometryObject* object)
+{
+    if (!object || m_paintEntries.contains(object)) {
+        return;
+    }
+
+    PaintEntry entry;
+    entry.bounds = objectPaintRect(object);
+    entry.proxy = m_paintIndex.insert(entry.bounds, object);
+    entry.order = m_nextPaintOrder++;
+    entry.layer = object->layer();
+    entry.live = isLiveObject(object);
+    entry.displayListScale = 0.0;
+    m_paintEntries.insert(object, entry);
+    noteTileLayer(entry.layer);
+
+    if (!entry.live) {
+        m_tileCache.invalidate(entry.layer, entry.bounds);
+    }
+
+    // Objects deleted without being removed first (e.g. Document::clear)
+    connect(object, &QObject::destroyed, this, [this, object]() {
+        removeFromPaintIndex(object);
+    });
+
+    updateSceneRect(entry.bounds);
+}
+
+void Canvas::updateInPaintIndex(Geometry::GeometryObject* object, bool repaint)
+{
+    auto it = m_paintEntries.find(object);
+    if (it == m_paintEntries.end()) {
+        return;
+    }
+
+    // Repaint where the object was and where it is now
+    QRectF oldBounds = it->bounds;
+    QString oldLayer = it->layer;
+    bool wasLive = it->live;
+    it->bounds = objectPaintRect(object);
+    it->layer = object->layer();
+    it->live = isLiveObject(object);
+    it->displayList.clear();
+    it->displayListScale = 0.0;
+    m_paintIndex.update(it->proxy, it->bounds);
+    noteTileLayer(it->layer);
+
+    // Changes to live objects leave the tiles alone; otherwise the tiles
+    // the object was or is now baked into are re-rendered
+    if (!wasLive) {
+        m_tileCache.invalidate(oldLayer, oldBounds);
+    }
+    if (!it->live) {
+        m_tileCache.invalidate(it->layer, it->bounds);
+    }
+
+    if (repaint) {
+        updateSceneRect(oldBounds | it->bounds);
+    }
+}
+
+void Canvas::updatePaintEntries(const QList<Geometry::GeometryObject*>& objects)
+{
+    // Coalesced changes and selection deltas; large ones repaint the
+    // viewport once rather than area by area
+    const int maxPartialRepaints = 64;
+    bool partial = objects.size() <= maxPartialRepaints;
+    for (Geometry::GeometryObject* object : objects) {
+        updateInPaintIndex(object, partial);
+    }
+    if (!partial) {
+        viewport()->update();
+    }
+}
+
+void Canvas::removeFromPaintIndex(Geometry::GeometryObject* object)
+{
+    auto it = m_paintEntries.find(object);
+    if (it == m_paintEntries.end()) {
+        return;
+    }
+
+    QRectF oldBounds = it->bounds;
+    if (!it->live) {
+        m_tileCache.invalidate(it->layer, oldBounds);
+    }
+    m_paintIndex.remove(it->proxy);
+    m_paintEntries.erase(it);
+    disconnect(object, &QObject::destroyed, this, nullptr);
+
+    updateSceneRect(oldBounds);
+}
+
+QList<Geometry::GeometryObject*> Canvas::objectsToPaint(const QRectF& rect) const
+{
+    QVector<QPair<quint64, Geometry::GeometryObject*>> ordered;
+    for (int proxy : m_paintIndex.query(rect)) {
+        auto* object = static_cast<Geometry::GeometryObject*>(m_paintIndex.userData(proxy));
+        ordered.append(qMakePair(m_paintEntries.value(object).order, object));
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    QList<Geometry::GeometryObject*> result;
+    result.reserve(ordered.size());
+    for (const auto& entry : ordered) {
+        result.append(entry.second);
+    }
+    return result;
+}
+
+void Canvas::updateSceneRect(const QRectF& rect)
+{
+    if (rect.isNull()) {
+        return;
+    }
+
+    // Pad by a few pixels for antialiasing and cosmetic strokes
+    QRect viewRect = mapFromScene(rect).boundingRect().adjusted(-3, -3, 3, 3);
+    viewport()->update(viewRect);
+}
+
+bool Canvas::isLiveObject(Geometry::GeometryObject* object)
+{
+    // Tools edit the selection, so selected objects are drawn live
+    return object->isSelected();
+}
+
+void Canvas::noteTileLayer(const QString& layer)
+{
+    if (m_document && !m_document->layers().contains(layer)) {
+        m_extraTileLayers.insert(layer);
+    }
+}
+
+QStringList Canvas::tileLayers() const
+{
+    QStringList layers = m_document->layers();
+    for (const QString& layer : m_extraTileLayers) {
+        if (!layers.contains(layer)) {
+            layers.append(layer);
+        }
+    }
+    return layers;
+}
+
+void Canvas::updateTileCapacity()
+{
+    double scale = transform().m11();
+    if (!m_document || scale <= 0.0) {
+        return;
+    }
+
+    int visibleLayers = 0;
+    for (const QString& layer : tileLayers()) {
+        if (m_document->isLayerVisible(layer)) {
+            ++visibleLayers;
+        }
+    }
+
+    // Every visible layer keeps its own tiles for the whole viewport
+    QRect range = TileCache::tileRange(scale, mapToScene(viewport()->rect()).boundingRect());
+    int visibleTiles = range.width() * range.height() * qMax(1, visibleLayers);
+    m_tileCache.setMaxTiles(qMax(MinCachedTiles, visibleTiles * TileCacheHeadroom));
+}
+
+void Canvas::drawTiles(QPainter* painter, const QRectF& rect)
+{
+    double scale = transform().m11();
+    if (scale <= 0.0) {
+        return;
+    }
+
+    // Jobs queued for another zoom level are no longer wanted. The fit
+    // zooms change the scale without going through setZoomLevel, so the
+    // capacity follows here too
+    if (scale != m_lastTileScale) {
+        m_tilePool.clear();
+        m_tileCache.clearPending();
+        m_lastTileScale = scale;
+        updateTileCapacity();
+    }
+    m_tileCache.beginFrame();
+
+    QRect range = TileCache::tileRange(scale, rect);
+
+    // Tiles are drawn unscaled in device space so they stay pixel-exact
+    painter->save();
+    QTransform sceneToDevice = painter->transform();
+    auto drawTileImage = [&](int x, int y, const QImage& image) {
+        QPointF topLeft = sceneToDevice.map(TileCache::tileRect(scale, x, y).topLeft());
+        painter->resetTransform();
+        painter->drawImage(QPoint(qRound(topLeft.x()), qRound(topLeft.y())), image);
+    };
+
+    for (const QString& layer : tileLayers()) {
+        if (!m_document->isLayerVisible(layer)) {
+            continue;
+        }
+
+        QVector<double> cachedScales;
+        bool cachedScalesKnown = false;
+
+        // Until a render arrives the tile's stale image stands in, or else
+        // a rescaled tile of another zoom level
+        auto drawStandIn = [&](const TileCache::Key& key, const QImage& staleImage) {
+            if (!staleImage.isNull()) {
+                drawTileImage(key.x, key.y, staleImage);
+                return true;
+            }
+            if (!cachedScalesKnown) {
+                cachedScales = m_tileCache.scales(layer, scale);
+                cachedScales.removeAll(scale);
+                cachedScalesKnown = true;
+            }
+            painter->setTransform(sceneToDevice);
+            return drawPlaceholder(painter, key, cachedScales);
+        };
+
+        for (int y = range.top(); y <= range.bottom(); ++y) {
+            for (int x = range.left(); x <= range.right(); ++x) {
+                TileCache::Key key{layer, scale, x, y};
+                QImage image;
+                bool stale = false;
+                if (m_tileCache.find(key, &image, &stale) && !stale) {
+                    m_renderStats.count(RenderStats::TileHits);
+                    if (!image.isNull()) {
+                        drawTileImage(x, y, image);
+                    }
+                    continue;
+                }
+                m_renderStats.count(RenderStats::TileMisses);
+
+                // While interacting, rendering waits for the idle pass
+                // wherever a stand-in is available
+                if (m_interacting && !m_tileCache.isPending(key) && drawStandIn(key, image)) {
+                    m_renderStats.count(RenderStats::TilePlaceholders);
+                    continue;
+                }
+
+                if (!m_tileCache.isPending(key)) {
+                    requestTile(key);
+                    if (m_tileCache.find(key, &image, &stale) && !stale) {
+                        continue;  // Known empty, nothing to draw
+                    }
+                }
+                if (drawStandIn(key, image)) {
+                    m_renderStats.count(RenderStats::TilePlaceholders);
+                }
+            }
+        }
+    }
+
+    painter->restore();
+    m_tileCache.trim();
+}
+
+bool Canvas::drawPlaceholder(QPainter* painter, const TileCache::Key& key,
+                             const QVector<double>& cachedScales) const
+{
+    // Use the closest zoom level that has cached tiles here, unless it
+    // would take too many of them to cover the tile
+    const int maxPlaceholderTiles = 16;
+    QRectF tileRect = TileCache::tileRect(key.scale, key.x, key.y);
+
+    for (double scale : cachedScales) {
+        QRect range = TileCache::tileRange(scale, tileRect);
+        if (range.width() * range.height() > maxPlaceholderTiles) {
+            continue;
+        }
+
+        bool drawn = false;
+        for (int y = range.top(); y <= range.bottom(); ++y) {
+            for (int x = range.left(); x <= range.right(); ++x) {
+                QImage image;
+                if (!m_tileCache.peek(TileCache::Key{key.layer, scale, x, y}, &image) || image.isNull()) {
+                    continue;
+                }
+
+                // Part of the cached tile inside the missing one, in scene
+                // units and in image pixels
+                QRectF sourceTile = TileCache::tileRect(scale, x, y);
+                QRectF target = sourceTile & tileRect;
+                double pixelsPerUnit = scale * image.devicePixelRatio();
+                QRectF source((target.topLeft() - sourceTile.topLeft()) * pixelsPerUnit,
+                              target.size() * pixelsPerUnit);
+                painter->drawImage(target, image, source);
+                drawn = true;
+            }
+        }
+        if (drawn) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Canvas::requestTile(const TileCache::Key& key)
+{
+    QRectF tileRect = TileCache::tileRect(key.scale, key.x, key.y);
+
+    // Snapshot the display lists of the layer's non-live objects overlapping
+    // the tile, in document order, recorded at the tile's level of detail
+    QVector<QByteArray> displayLists;
+    for (Geometry::GeometryObject* obj : objectsToPaint(tileRect)) {
+        PaintEntry& entry = m_paintEntries[obj];
+        if (!entry.live && entry.layer == key.layer) {
+            bool cached = (entry.displayListScale == key.scale);
+            if (!cached) {
+                entry.displayList = recordDisplayList(obj, key.scale);
+                entry.displayListScale = key.scale;
+            }
+            m_renderStats.countDisplayList(obj->type(), cached);
+            displayLists.append(entry.displayList);
+        }
+    }
+    if (displayLists.isEmpty()) {
+        m_tileCache.insert(key, QImage());
+        return;
+    }
+
+    quint64 ticket = m_tileCache.markPending(key);
+    qreal dpr = viewport()->devicePixelRatioF();
+    m_tilePool.start([this, key, ticket, displayLists, tileRect, dpr]() {
+        QImage image = rasterizeTile(displayLists, tileRect, key.scale, dpr);
+        QMetaObject::invokeMethod(this, [this, key, ticket, image]() {
+            tileRendered(key, ticket, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void Canvas::tileRendered(const TileCache::Key& key, quint64 ticket, const QImage& image)
+{
+    // Results for tiles invalidated while rendering are dropped; an
+    // accepted one replaces the stale image shown meanwhile
+    if (m_tileCache.completePending(key, ticket, image) && key.scale == transform().m11()) {
+        updateSceneRect(TileCache::tileRect(key.scale, key.x, key.y));
+    }
+}
+
+QByteArray Canvas::recordDisplayList(Geometry::GeometryObject* object, double scale) const
+{
+    // Recorded in scene units; the scale only selects the level of detail
+    QPicture picture;
+    QPainter painter(&picture);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(font());
+    QColor color = m_document ? m_document->layerColor(m_document->objectLayerId(object)) : QColor(Qt::black);
+    object->drawAtScale(&painter, color, scale);
+    painter.end();
+    return QByteArray(picture.data(), static_cast<int>(picture.size()));
+}
+
+void Canvas::clearDisplayLists(const QString& layer)
+{
+    for (auto it = m_paintEntries.begin(); it != m_paintEntries.end(); ++it) {
+        if (it->layer == layer) {
+            it->displayList.clear();
+            it->displayListScale = 0.0;
+        }
+    }
+}
+
+QImage Canvas::rasterizeTile(const QVector<QByteArray>& displayLists, const QRectF& tileRect,
+                             double scale, qreal devicePixelRatio)
+{
+    // Runs on a worker thread: touches nothing but its arguments
+    QImage image(QSize(TileCache::TileSize, TileCache::TileSize) * devicePixelRatio,
+                 QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(scale, scale);
+    painter.translate(-tileRect.topLeft());
+
+    // Each replay gets its own QPicture, so no picture data is shared
+    // between threads
+    for (const QByteArray& displayList : displayLists) {
+        QPicture picture;
+        picture.setData(displayList.constData(), static_cast<uint>(displayList.size()));
+        picture.play(&painter);
+    }
+    painter.end();
+    return image;
+}
+
+void Canvas::beginInteraction()
+{
+    if (!m_interacting) {
+        m_interacting = true;
+        setRenderHint(QPainter::Antialiasing, false);
+        setRenderHint(QPainter::SmoothPixmapTransform, false);
+    }
+    m_interactionTimer.start();
+}
+
+void Canvas::endInteraction()
+{
+    m_interactionTimer.stop();
+    if (!m_interacting) {
+        return;
+    }
+
+    m_interacting = false;
+    setRenderHint(QPainter::Antialiasing);
+    setRenderHint(QPainter::SmoothPixmapTransform);
+    viewport()->update();
 }
 
 void Canvas::updateGrid()
@@ -543,30 +1130,20 @@ void Canvas::drawGrid(QPainter* painter, const QRectF& rect)
         screenSpacing = gridSpacing * m_zoomLevel;
     }
 
-    // Calculate grid bounds
-    int left = static_cast<int>(std::floor(rect.left() / gridSpacing));
-    int right = static_cast<int>(std::ceil(rect.right() / gridSpacing));
-    int top = static_cast<int>(std::floor(rect.top() / gridSpacing));
-    int bottom = static_cast<int>(std::ceil(rect.bottom() / gridSpacing));
-
     // Draw grid lines with alpha based on spacing level
     int alpha = 100;
     if (gridSpacing != baseGridSpacing) {
         // Lighter color for scaled grid lines
         alpha = 60;
     }
-    QPen gridPen(QColor(220, 220, 220, alpha));
+    QColor gridColor = m_gridColor;
+    gridColor.setAlpha(alpha);
+    QPen gridPen(gridColor);
     painter->setPen(gridPen);
 
-    for (int i = left; i <= right; ++i) {
-        double x = i * gridSpacing;
-        painter->drawLine(QPointF(x, rect.top()), QPointF(x, rect.bottom()));
-    }
-
-    for (int i = top; i <= bottom; ++i) {
-        double y = i * gridSpacing;
-        painter->drawLine(QPointF(rect.left(), y), QPointF(rect.right(), y));
-    }
+    // One batched call; the painter clips lines beyond the exposed area
+    updateGridLines(rect, gridSpacing);
+    painter->drawLines(m_gridLines);
 
     // Draw axes (always visible, darker)
     QPen axisPen(QColor(180, 180, 180), 2.0 / m_zoomLevel);
@@ -575,6 +1152,34 @@ void Canvas::drawGrid(QPainter* painter, const QRectF& rect)
     painter->drawLine(QPointF(rect.left(), 0), QPointF(rect.right(), 0));
 }
 
+void Canvas::updateGridLines(const QRectF& rect, double gridSpacing)
+{
+    if (gridSpacing == m_gridLinesSpacing && m_gridLinesRect.contains(rect)) {
+        return;
+    }
+
+    // Cover the area plus its own size on every side, snapped to the grid
+    QRectF area = rect.adjusted(-rect.width(), -rect.height(), rect.width(), rect.height());
+    int left = static_cast<int>(std::floor(area.left() / gridSpacing));
+    int right = static_cast<int>(std::ceil(area.right() / gridSpacing));
+    int top = static_cast<int>(std::floor(area.top() / gridSpacing));
+    int bottom = static_cast<int>(std::ceil(area.bottom() / gridSpacing));
+    m_gridLinesRect = QRectF(QPointF(left * gridSpacing, top * gridSpacing),
+                             QPointF(right * gridSpacing, bottom * gridSpacing));
+    m_gridLinesSpacing = gridSpacing;
+
+    m_gridLines.clear();
+    m_gridLines.reserve((right - left + 1) + (bottom - top + 1));
+    for (int i = left; i <= right; ++i) {
+        double x = i * gridSpacing;
+        m_gridLines.append(QLineF(x, m_gridLinesRect.top(), x, m_gridLinesRect.bottom()));
+    }
+    for (int i = top; i <= bottom; ++i) {
+        double y = i * gridSpacing;
+        m_gridLines.append(QLineF(m_gridLinesRect.left(), y, m_gridLinesRect.right(), y));
+    }
+}
+
 void Canvas::drawOriginIndicator(QPainter* painter)
 {
     // Draw a visible indicator at (0,0)
@@ -596,5 +1201,102 @@ void Canvas::drawOriginIndicator(QPainter* painter)
     painter->restore();
 }
 
+void Canvas::collectSelfIntersections(Geometry::GeometryObject* object,
+                                      QVector<QPointF>* crossings, QVector<QPointF>* vertices)
+{
+    auto* polyline = qobject_cast<Geometry::Polyline*>(object);
+    if (!polyline) {
+        return;
+    }
+
+    // Both ends of every segment involved are flagged
+    const auto& polylineVertices = polyline->vertices();
+    int n = polylineVertices.size();
+    QSet<int> flagged;
+    for (const auto& hit : polyline->selfIntersections()) {
+        crossings->append(hit.point);
+        for (int segment : {hit.firstSegment, hit.secondSegment}) {
+            flagged.insert(segment);
+            flagged.insert((segment + 1) % n);
+        }
+    }
+    for (int vertex : flagged) {
+        vertices->append(polylineVertices.position(vertex));
+    }
+
+    Geometry::SeamAllowance* seam = polyline->seamAllowance();
+    if (seam && seam->isEnabled()) {
+        *crossings += seam->selfIntersections();
+    }
+}
+
+void Canvas::drawSelfIntersections(QPainter* painter, const QList<Geometry::GeometryObject*>& objects)
+{
+    if (!m_selfIntersectionsVisible) {
+        return;
+    }
+
+    QVector<QPointF> crossings;
+    QVector<QPointF> vertices;
+    for (Geometry::GeometryObject* obj : objects) {
+        collectSelfIntersections(obj, &crossings, &vertices);
+    }
+    if (crossings.isEmpty()) {
+        return;
+    }
+
+    painter->save();
+    QPen pen(QColor(220, 0, 0), 2.0);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
+
+    // Crossings as an X, flagged vertices ringed
+    const double r = SelfIntersectionMarkRadius;
+    for (const QPointF& point : crossings) {
+        painter->drawLine(point + QPointF(-r, -r), point + QPointF(r, r));
+        painter->drawLine(point + QPointF(-r, r), point + QPointF(r, -r));
+    }
+    for (const QPointF& point : vertices) {
+        painter->drawEllipse(point, r, r);
+    }
+    painter->restore();
+}
+
+void Canvas::drawRenderStats(QPainter* painter)
+{
+    if (!m_renderStatsVisible) {
+        return;
+    }
+
+    // Drawn in device space, outside the timed phases
+    QStringList lines = m_renderStats.summary();
+    painter->save();
+    painter->resetTransform();
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    QFont hudFont("Monospace");
+    hudFont.setStyleHint(QFont::TypeWriter);
+    hudFont.setPointSizeF(8.0);
+    painter->setFont(hudFont);
+    QFontMetrics metrics(hudFont);
+
+    int width = 0;
+    for (const QString& line : lines) {
+        width = qMax(width, metrics.horizontalAdvance(line));
+    }
+    const int margin = 6;
+    QRect box(margin, margin, width + 2 * margin, lines.size() * metrics.height() + 2 * margin);
+    painter->fillRect(box, QColor(0, 0, 0, 160));
+
+    painter->setPen(Qt::white);
+    int y = box.top() + margin + metrics.ascent();
+    for (const QString& line : lines) {
+        painter->drawText(box.left() + margin, y, line);
+        y += metrics.height();
+    }
+    painter->restore();
+}
+
 } // namespace UI
 } // namespace PatternCAD
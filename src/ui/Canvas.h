@@ -11,6 +11,16 @@
 #include <QGraphicsScene>
 #include <QWheelEvent>
 #include <QMouseEvent>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QByteArray>
+#include <QColor>
+#include <QLineF>
+#include "geometry/AABBTree.h"
+#include "TileCache.h"
+#include "RenderStats.h"
 
 namespace PatternCAD {
 
@@ -36,6 +46,30 @@ class DimensionRenderer;
  * - Snap-to-grid support
  * - Interactive drawing and selection
  * - Real-time tool feedback
+ *
+ * Committed geometry is rasterized into cached per-layer tiles; only live
+ * objects (the selected ones, which tools edit) and the tool overlay are
+ * drawn directly on every paint. Tiles are rasterized on a worker pool from
+ * per-object display lists recorded on the GUI thread, with cached tiles of
+ * the nearest other zoom level shown until they arrive. Edits keep the
+ * affected tiles' previous images on screen, with the objects that changed
+ * drawn directly over them, until the re-rendered tiles are swapped in. The
+ * cache is sized from the tiles the viewport shows across its visible layers.
+ *
+ * While a gesture (wheel zoom, pan, tool drag) is in progress the canvas
+ * renders in a low-quality interactive mode: no antialiasing or smooth
+ * image scaling, coarser outlines for live objects, and rescaled tiles of
+ * the previous zoom level instead of new renders. The full-quality pass
+ * runs once the view has been idle for a short timeout.
+ *
+ * Each paint phase is timed and counted in renderStats() while collection
+ * is enabled; the render statistics overlay turns it on and shows the
+ * rolling figures in the top-left corner of the view.
+ *
+ * Pieces whose outline or seam allowance crosses itself are flagged with
+ * markers at the crossings and on the vertices of the offending segments.
+ * The checks are cached per piece revision, so only edited pieces are
+ * swept again.
  */
 class Canvas : public QGraphicsView
 {
@@ -73,6 +107,15 @@ public:
     void setActiveTool(Tools::Tool* tool);
     Tools::Tool* activeTool() const;
 
+    // Render statistics
+    RenderStats& renderStats();
+    bool renderStatsVisible() const;
+    void setRenderStatsVisible(bool visible);
+
+    // Self-intersection markers
+    bool selfIntersectionsVisible() const;
+    void setSelfIntersectionsVisible(bool visible);
+
 signals:
     void zoomChanged(double zoom);
     void cursorPositionChanged(const QPointF& position);
@@ -82,6 +125,8 @@ signals:
 protected:
     // Event handlers
     bool event(QEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
@@ -100,17 +145,94 @@ private:
     double m_zoomLevel;
     bool m_gridVisible;
     bool m_snapToGrid;
+    QColor m_gridColor;
+
+    // Grid lines in scene units at one spacing, covering m_gridLinesRect
+    // (a margin around the last painted area, so panning reuses them)
+    QVector<QLineF> m_gridLines;
+    QRectF m_gridLinesRect;
+    double m_gridLinesSpacing;
     QPointF m_lastMousePos;
 
     // Pan state
     bool m_isPanning;
     QPoint m_panStartPos;
 
+    // Interactive (low-quality) rendering during gestures
+    bool m_interacting;
+    QTimer m_interactionTimer;
+
+    // Painted extent of each document object, for culling and partial
+    // repaints. 'order' is the document (z) order; 'layer' and 'live' are
+    // as of the last update, so tiles of the previous state can be dropped.
+    // Non-live objects carry their recorded drawing (serialized QPicture),
+    // an immutable snapshot the tile workers replay. It is recorded lazily
+    // at the level of detail of displayListScale (0 = not recorded).
+    struct PaintEntry {
+        int proxy;
+        quint64 order;
+        QRectF bounds;
+        QString layer;
+        bool live;
+        QByteArray displayList;
+        double displayListScale;
+    };
+    Geometry::AABBTree m_paintIndex;
+    QHash<Geometry::GeometryObject*, PaintEntry> m_paintEntries;
+    quint64 m_nextPaintOrder;
+
+    // Rendered tiles of non-live objects, and layers seen on objects that
+    // are not (or no longer) in the document's layer list
+    TileCache m_tileCache;
+    QSet<QString> m_extraTileLayers;
+    QThreadPool m_tilePool;
+    double m_lastTileScale;
+
+    // Frame profiling
+    RenderStats m_renderStats;
+    bool m_renderStatsVisible;
+
+    bool m_selfIntersectionsVisible;
+
     // Helper methods
     void setupScene();
     void updateGrid();
     void drawGrid(QPainter* painter, const QRectF& rect);
+    void updateGridLines(const QRectF& rect, double gridSpacing);
     void drawOriginIndicator(QPainter* painter);
+    void drawRenderStats(QPainter* painter);
+    void drawSelfIntersections(QPainter* painter, const QList<Geometry::GeometryObject*>& objects);
+    static void collectSelfIntersections(Geometry::GeometryObject* object,
+                                         QVector<QPointF>* crossings, QVector<QPointF>* vertices);
+
+    // Interactive mode
+    void beginInteraction();
+    void endInteraction();
+
+    // Paint index maintenance
+    QRectF objectPaintRect(Geometry::GeometryObject* object) const;
+    void rebuildPaintIndex();
+    void addToPaintIndex(Geometry::GeometryObject* object);
+    void updateInPaintIndex(Geometry::GeometryObject* object, bool repaint = true);
+    void updatePaintEntries(const QList<Geometry::GeometryObject*>& objects);
+    void removeFromPaintIndex(Geometry::GeometryObject* object);
+    QList<Geometry::GeometryObject*> objectsToPaint(const QRectF& rect) const;
+    void updateSceneRect(const QRectF& rect);
+
+    // Tile rendering
+    static bool isLiveObject(Geometry::GeometryObject* object);
+    void noteTileLayer(const QString& layer);
+    QStringList tileLayers() const;
+    void updateTileCapacity();
+    void drawTiles(QPainter* painter, const QRectF& rect);
+    bool drawPlaceholder(QPainter* painter, const TileCache::Key& key,
+                         const QVector<double>& cachedScales) const;
+    void requestTile(const TileCache::Key& key);
+    void tileRendered(const TileCache::Key& key, quint64 ticket, const QImage& image);
+    QByteArray recordDisplayList(Geometry::GeometryObject* object, double scale) const;
+    void clearDisplayLists(const QString& layer);
+    static QImage rasterizeTile(const QVector<QByteArray>& displayLists, const QRectF& tileRect,
+                                double scale, qreal devicePixelRatio);
 };
 
 } // namespace UI
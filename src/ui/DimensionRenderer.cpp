@@ -46,6 +46,23 @@ void DimensionRenderer::renderDimensions(QPainter* painter, Geometry::GeometryOb
     }
 }
 
+QRectF DimensionRenderer::annotationBounds(Geometry::GeometryObject* object) const
+{
+    if (!m_showDimensions || !object || !object->isSelected()) {
+        return QRectF();
+    }
+
+    // Dimension lines sit up to 25 units off the geometry (extension lines
+    // overshoot by 30%) and labels up to 15 units, centred on their anchor.
+    // The perimeter label is the widest one drawn.
+    QFont font;
+    font.setPointSize(10);
+    font.setBold(true);
+    QRect label = QFontMetrics(font).boundingRect("Perimeter: 00000.0 mm").adjusted(-3, -2, 3, 2);
+    double reach = 25.0 * 1.3 + qMax(label.width(), label.height()) / 2.0;
+    return object->boundingRect().adjusted(-reach, -reach, reach, reach);
+}
+
 void DimensionRenderer::drawLineDimension(QPainter* painter, Geometry::Line* line)
 {
     double lengthMm = line->length();
@@ -105,26 +122,14 @@ void DimensionRenderer::drawPolylineDimension(QPainter* painter, Geometry::Polyl
 {
     painter->save();
 
-    auto vertices = polyline->vertices();
+    const auto& vertices = polyline->vertices();
     if (vertices.size() < 2) {
         painter->restore();
         return;
     }
 
-    // Calculate total perimeter
-    double totalLength = 0.0;
-    for (int i = 0; i < vertices.size(); ++i) {
-        int nextIdx = (i + 1) % vertices.size();
-        if (!polyline->isClosed() && nextIdx == 0) {
-            break;
-        }
-
-        QPointF p1 = vertices[i].position;
-        QPointF p2 = vertices[nextIdx].position;
-        QPointF delta = p2 - p1;
-        double segmentLength = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-        totalLength += segmentLength;
-    }
+    // Total perimeter (curved segments use their arc length)
+    double totalLength = polyline->perimeter();
 
     // Draw total perimeter at centroid
     QPointF centroid(0, 0);
@@ -144,24 +149,15 @@ void DimensionRenderer::drawPolylineDimension(QPainter* painter, Geometry::Polyl
         font.setPointSize(9);
         painter->setFont(font);
 
-        for (int i = 0; i < vertices.size(); ++i) {
-            int nextIdx = (i + 1) % vertices.size();
-            if (!polyline->isClosed() && nextIdx == 0) {
-                break;
-            }
-
-            QPointF p1 = vertices[i].position;
-            QPointF p2 = vertices[nextIdx].position;
-            QPointF delta = p2 - p1;
-            double segmentLength = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
-
-            // Calculate midpoint and normal for text placement
-            QPointF midpoint = (p1 + p2) / 2.0;
-            QPointF normal(-delta.y(), delta.x());
-            double normalLen = std::sqrt(normal.x() * normal.x() + normal.y() * normal.y());
-            if (normalLen > 0.001) {
-                normal /= normalLen;
-            }
+        for (int i = 0; i < polyline->segmentCount(); ++i) {
+            Geometry::CurveSegment segment = polyline->segment(i);
+            double segmentLength = segment.length();
+
+            // Place text at the arc-length midpoint, offset along the normal
+            double midT = segment.parameterAtFraction(0.5);
+            QPointF midpoint = segment.pointAt(midT);
+            QPointF tangent = segment.tangentAt(midT);
+            QPointF normal(-tangent.y(), tangent.x());
 
             QString lengthText = Units::formatLength(segmentLength, 1);
             drawDimensionText(painter, midpoint + normal * 10.0, lengthText);
@@ -33,6 +33,9 @@ public:
     // Render dimensions for an object
     void renderDimensions(QPainter* painter, Geometry::GeometryObject* object);
 
+    // Area renderDimensions() may paint for an object (null if it draws nothing)
+    QRectF annotationBounds(Geometry::GeometryObject* object) const;
+
     // Settings
     void setShowDimensions(bool show) { m_showDimensions = show; }
     bool showDimensions() const { return m_showDimensions; }
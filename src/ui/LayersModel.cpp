@@ -0,0 +1,204 @@
+/**
+ * LayersModel.cpp
+ *
+ * Implementation of LayersModel
+ */
+
+#include "LayersModel.h"
+#include "core/Document.h"
+#include <QIcon>
+#include <QPainter>
+#include <QPixmap>
+
+namespace PatternCAD {
+namespace UI {
+
+LayersModel::LayersModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_document(nullptr)
+    , m_countsUpdateScheduled(false)
+{
+}
+
+LayersModel::~LayersModel()
+{
+}
+
+void LayersModel::setDocument(Document* document)
+{
+    if (m_document) {
+        disconnect(m_document, nullptr, this, nullptr);
+    }
+
+    m_document = document;
+
+    if (m_document) {
+        connect(m_document, &Document::layerAdded, this, &LayersModel::onLayerAdded);
+        connect(m_document, &Document::layerRemoved, this, &LayersModel::onLayerRemoved);
+        connect(m_document, &Document::layerRenamed, this, &LayersModel::onLayerRenamed);
+        // Color changes are reported through layerVisibilityChanged as well
+        connect(m_document, &Document::layerVisibilityChanged, this,
+                [this](const QString& layerName, bool) { onLayerChanged(layerName); });
+        connect(m_document, &Document::layerLockChanged, this,
+                [this](const QString& layerName, bool) { onLayerChanged(layerName); });
+        connect(m_document, &Document::objectAdded, this, &LayersModel::scheduleCountsUpdate);
+        connect(m_document, &Document::objectRemoved, this, &LayersModel::scheduleCountsUpdate);
+        connect(m_document, &Document::objectsChanged, this, &LayersModel::scheduleCountsUpdate);
+        connect(m_document, &Document::cleared, this, &LayersModel::reload);
+        connect(m_document, &QObject::destroyed, this, [this]() {
+            m_document = nullptr;
+            reload();
+        });
+    }
+
+    reload();
+}
+
+void LayersModel::reload()
+{
+    beginResetModel();
+    m_layers = m_document ? m_document->layers() : QStringList();
+    endResetModel();
+}
+
+QString LayersModel::layerAt(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.row() >= m_layers.size()) {
+        return QString();
+    }
+    return m_layers[index.row()];
+}
+
+QModelIndex LayersModel::indexOf(const QString& layerName) const
+{
+    int row = m_layers.indexOf(layerName);
+    return (row >= 0) ? index(row) : QModelIndex();
+}
+
+int LayersModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_layers.size();
+}
+
+QVariant LayersModel::data(const QModelIndex& index, int role) const
+{
+    if (!m_document || !index.isValid() || index.row() >= m_layers.size()) {
+        return QVariant();
+    }
+
+    const QString& layerName = m_layers[index.row()];
+    switch (role) {
+    case Qt::DisplayRole: {
+        QString displayText = QString("%1 (%2)").arg(layerName)
+                                  .arg(m_document->objectCountOnLayer(layerName));
+        if (m_document->isLayerLocked(layerName)) {
+            displayText += " 🔒";
+        }
+        return displayText;
+    }
+    case Qt::CheckStateRole:
+        return m_document->isLayerVisible(layerName) ? Qt::Checked : Qt::Unchecked;
+    case Qt::DecorationRole: {
+        QPixmap pixmap(16, 16);
+        pixmap.fill(m_document->layerColor(layerName));
+        QPainter painter(&pixmap);
+        painter.setPen(Qt::black);
+        painter.drawRect(0, 0, 15, 15);
+        return QIcon(pixmap);
+    }
+    case LayerNameRole:
+        return layerName;
+    case LayerLockedRole:
+        return m_document->isLayerLocked(layerName);
+    }
+    return QVariant();
+}
+
+bool LayersModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!m_document || role != Qt::CheckStateRole || !index.isValid() || index.row() >= m_layers.size()) {
+        return false;
+    }
+
+    // The document's layerVisibilityChanged signal refreshes the row
+    QString layerName = m_layers[index.row()];
+    bool visible = (value.toInt() == Qt::Checked);
+    m_document->setLayerVisible(layerName, visible);
+    emit visibilityToggled(layerName, visible);
+    return true;
+}
+
+Qt::ItemFlags LayersModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return QAbstractListModel::flags(index) | Qt::ItemIsUserCheckable;
+}
+
+void LayersModel::onLayerAdded(const QString& layerName)
+{
+    // Pick up the document's display position for the new layer
+    int row = m_document ? m_document->layers().indexOf(layerName) : -1;
+    if (row < 0 || row > m_layers.size()) {
+        row = m_layers.size();
+    }
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_layers.insert(row, layerName);
+    endInsertRows();
+}
+
+void LayersModel::onLayerRemoved(const QString& layerName)
+{
+    int row = m_layers.indexOf(layerName);
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_layers.removeAt(row);
+    endRemoveRows();
+}
+
+void LayersModel::onLayerRenamed(const QString& oldName, const QString& newName)
+{
+    int row = m_layers.indexOf(oldName);
+    if (row < 0) {
+        return;
+    }
+
+    m_layers[row] = newName;
+    QModelIndex changed = index(row);
+    emit dataChanged(changed, changed);
+}
+
+void LayersModel::onLayerChanged(const QString& layerName)
+{
+    QModelIndex changed = indexOf(layerName);
+    if (changed.isValid()) {
+        emit dataChanged(changed, changed);
+    }
+}
+
+void LayersModel::scheduleCountsUpdate()
+{
+    // Imports and batch edits add or move many objects at once; refresh
+    // the counts once they have all landed
+    if (m_countsUpdateScheduled) {
+        return;
+    }
+    m_countsUpdateScheduled = true;
+    QMetaObject::invokeMethod(this, &LayersModel::updateCounts, Qt::QueuedConnection);
+}
+
+void LayersModel::updateCounts()
+{
+    m_countsUpdateScheduled = false;
+    if (!m_layers.isEmpty()) {
+        emit dataChanged(index(0), index(m_layers.size() - 1), {Qt::DisplayRole});
+    }
+}
+
+} // namespace UI
+} // namespace PatternCAD
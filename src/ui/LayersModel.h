@@ -0,0 +1,72 @@
+/**
+ * LayersModel.h
+ *
+ * List model over the layers of a document
+ */
+
+#ifndef PATTERNCAD_LAYERSMODEL_H
+#define PATTERNCAD_LAYERSMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+namespace PatternCAD {
+
+class Document;
+
+namespace UI {
+
+/**
+ * LayersModel exposes the document's layers in display order:
+ * - Display text is "name (object count)", with a lock marker
+ * - Check state is the layer visibility and is editable
+ * - Decoration is a swatch of the layer color
+ * - Document layer signals map to row-level updates; object count
+ *   refreshes are coalesced into one dataChanged per event loop pass
+ */
+class LayersModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        LayerNameRole = Qt::UserRole,
+        LayerLockedRole
+    };
+
+    explicit LayersModel(QObject* parent = nullptr);
+    ~LayersModel();
+
+    void setDocument(Document* document);
+    void reload();
+
+    QString layerAt(const QModelIndex& index) const;
+    QModelIndex indexOf(const QString& layerName) const;
+
+    // QAbstractItemModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+signals:
+    // Visibility toggled through the view's check box
+    void visibilityToggled(const QString& layerName, bool visible);
+
+private:
+    void onLayerAdded(const QString& layerName);
+    void onLayerRemoved(const QString& layerName);
+    void onLayerRenamed(const QString& oldName, const QString& newName);
+    void onLayerChanged(const QString& layerName);
+    void scheduleCountsUpdate();
+    void updateCounts();
+
+    Document* m_document;
+    QStringList m_layers;
+    bool m_countsUpdateScheduled;
+};
+
+} // namespace UI
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_LAYERSMODEL_H
@@ -5,6 +5,7 @@
  */
 
 #include "LayersPanel.h"
+#include "LayersModel.h"
 #include "core/Document.h"
 #include "geometry/GeometryObject.h"
 #include <QHBoxLayout>
@@ -13,8 +14,6 @@
 #include <QMessageBox>
 #include <QColorDialog>
 #include <QPushButton>
-#include <QPixmap>
-#include <QPainter>
 #include <QRandomGenerator>
 #include <QMenu>
 
@@ -24,6 +23,7 @@ namespace UI {
 LayersPanel::LayersPanel(QWidget* parent)
     : QWidget(parent)
     , m_layout(nullptr)
+    , m_model(nullptr)
     , m_layerList(nullptr)
     , m_addButton(nullptr)
     , m_removeButton(nullptr)
@@ -51,25 +51,30 @@ void LayersPanel::setupUi()
     titleLabel->setStyleSheet("font-weight: bold;");
     m_layout->addWidget(titleLabel);
 
-    // Layer list
-    m_layerList = new QListWidget(this);
+    // Layer list; rows are fed incrementally by the model
+    m_model = new LayersModel(this);
+    m_layerList = new QListView(this);
+    m_layerList->setModel(m_model);
     m_layerList->setSelectionMode(QAbstractItemView::SingleSelection);
-
-    // Enable drag-and-drop reordering
-    m_layerList->setDragDropMode(QAbstractItemView::InternalMove);
-    m_layerList->setDefaultDropAction(Qt::MoveAction);
+    m_layerList->setUniformItemSizes(true);
 
     // Enable context menu
     m_layerList->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_layerList, &QWidget::customContextMenuRequested,
             this, &LayersPanel::onLayerContextMenu);
 
-    connect(m_layerList, &QListWidget::itemSelectionChanged,
+    connect(m_layerList->selectionModel(), &QItemSelectionModel::currentChanged,
             this, &LayersPanel::onLayerSelectionChanged);
-    connect(m_layerList, &QListWidget::itemChanged,
-            this, &LayersPanel::onLayerItemChanged);
-    connect(m_layerList, &QListWidget::itemDoubleClicked,
+    connect(m_layerList, &QListView::doubleClicked,
             this, &LayersPanel::onLayerDoubleClicked);
+    connect(m_model, &LayersModel::visibilityToggled,
+            this, &LayersPanel::layerVisibilityChanged);
+    // A reset drops the current row; restore the active layer
+    connect(m_model, &QAbstractItemModel::modelReset, this, [this]() {
+        if (m_document) {
+            selectLayer(m_document->activeLayer());
+        }
+    });
     m_layout->addWidget(m_layerList);
 
     // Button layout
@@ -104,12 +109,6 @@ void LayersPanel::setupUi()
 
     buttonLayout->addStretch();
     m_layout->addLayout(buttonLayout);
-
-    // Add default layer
-    QListWidgetItem* defaultItem = new QListWidgetItem("Default", m_layerList);
-    defaultItem->setFlags(defaultItem->flags() | Qt::ItemIsUserCheckable);
-    defaultItem->setCheckState(Qt::Checked);
-    defaultItem->setSelected(true);
 }
 
 Document* LayersPanel::document() const
@@ -126,96 +125,43 @@ void LayersPanel::setDocument(Document* document)
 
     m_document = document;
 
-    // Connect document signals
+    // Connect document signals; everything else reaches the view through the model
     if (m_document) {
-        connect(m_document, &Document::layerAdded,
-                this, &LayersPanel::refreshLayers);
-        connect(m_document, &Document::layerRemoved,
-                this, &LayersPanel::refreshLayers);
-        connect(m_document, &Document::layerRenamed,
-                this, [this](const QString&, const QString&) {
-            refreshLayers();
-        });
         connect(m_document, &Document::activeLayerChanged,
                 this, [this](const QString& layerName) {
             m_activeLayer = layerName;
-            refreshLayers();
+            selectLayer(layerName);
         });
-        connect(m_document, &Document::objectAdded,
-                this, &LayersPanel::refreshLayers);
-        connect(m_document, &Document::objectRemoved,
-                this, &LayersPanel::refreshLayers);
+        m_activeLayer = m_document->activeLayer();
     }
 
-    refreshLayers();
+    m_model->setDocument(m_document);
 }
 
 void LayersPanel::refreshLayers()
 {
-    // Block signals during refresh to avoid triggering change events
-    m_layerList->blockSignals(true);
-    m_layerList->clear();
-
-    if (!m_document) {
-        // Add default layer when no document
-        QListWidgetItem* defaultItem = new QListWidgetItem("Default", m_layerList);
-        defaultItem->setFlags(defaultItem->flags() | Qt::ItemIsUserCheckable);
-        defaultItem->setCheckState(Qt::Checked);
-        defaultItem->setSelected(true);
-        m_layerList->blockSignals(false);
-        return;
-    }
-
-    // Load layers from document
-    for (const QString& layerName : m_document->layers()) {
-        QListWidgetItem* item = new QListWidgetItem(m_layerList);
-        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
-        item->setCheckState(m_document->isLayerVisible(layerName) ? Qt::Checked : Qt::Unchecked);
-
-        // Store the real layer name in UserRole for later retrieval
-        item->setData(Qt::UserRole, layerName);
-
-        // Store layer name and lock state in user data
-        item->setData(Qt::UserRole, layerName);
-        bool isLocked = m_document->isLayerLocked(layerName);
-        item->setData(Qt::UserRole + 1, isLocked);
-
-        // Create colored icon for the layer
-        QColor layerColor = m_document->layerColor(layerName);
-        QPixmap pixmap(16, 16);
-        pixmap.fill(layerColor);
-        QPainter painter(&pixmap);
-        painter.setPen(Qt::black);
-        painter.drawRect(0, 0, 15, 15);
-        item->setIcon(QIcon(pixmap));
-
-        // Count objects on this layer
-        int objectCount = m_document->objectsOnLayer(layerName).size();
-        QString displayText = QString("%1 (%2)").arg(layerName).arg(objectCount);
-
-        // Add lock indicator if locked
-        if (isLocked) {
-            displayText += " 🔒";
-        }
-
-        item->setText(displayText);
-
-        if (layerName == m_document->activeLayer()) {
-            item->setSelected(true);
-            m_activeLayer = layerName;
-        }
-    }
+    m_model->reload();
+}
 
-    m_layerList->blockSignals(false);
+QString LayersPanel::currentLayerName() const
+{
+    return m_model->layerAt(m_layerList->currentIndex());
 }
 
-void LayersPanel::updateLayerList()
+void LayersPanel::selectLayer(const QString& layerName)
 {
-    refreshLayers();
+    QModelIndex index = m_model->indexOf(layerName);
+    if (index.isValid() && index != m_layerList->currentIndex()) {
+        m_layerList->setCurrentIndex(index);
+    }
 }
 
 void LayersPanel::onAddLayer()
 {
+    if (!m_document) {
+        return;
+    }
+
     bool ok;
     QString layerName = QInputDialog::getText(this,
                                               "Add Layer",
@@ -225,78 +171,55 @@ void LayersPanel::onAddLayer()
                                               &ok);
 
     if (ok && !layerName.isEmpty()) {
-        // Add layer to document (which will trigger refresh via signal)
-        if (m_document) {
-            // Check if layer already exists
-            if (m_document->layers().contains(layerName)) {
-                QMessageBox::warning(this, "Layer Exists",
-                                   "A layer with this name already exists.");
-                return;
-            }
-
-            // Generate a random color for the new layer
-            int hue = QRandomGenerator::global()->bounded(360);
-            QColor newColor = QColor::fromHsv(hue, 200, 200);
-            m_document->addLayer(layerName, newColor);
-        } else {
-            // No document: add to UI only
-            for (int i = 0; i < m_layerList->count(); ++i) {
-                if (m_layerList->item(i)->text() == layerName) {
-                    QMessageBox::warning(this, "Layer Exists",
-                                       "A layer with this name already exists.");
-                    return;
-                }
-            }
-
-            QListWidgetItem* item = new QListWidgetItem(layerName, m_layerList);
-            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
-            item->setCheckState(Qt::Checked);
+        // Check if layer already exists
+        if (m_document->layers().contains(layerName)) {
+            QMessageBox::warning(this, "Layer Exists",
+                               "A layer with this name already exists.");
+            return;
         }
+
+        // Generate a random color for the new layer (the model picks it up via signal)
+        int hue = QRandomGenerator::global()->bounded(360);
+        QColor newColor = QColor::fromHsv(hue, 200, 200);
+        m_document->addLayer(layerName, newColor);
     }
 }
 
 void LayersPanel::onRemoveLayer()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem) {
+    QString layerName = currentLayerName();
+    if (layerName.isEmpty() || !m_document) {
         QMessageBox::information(this, "No Selection",
                                 "Please select a layer to remove.");
         return;
     }
 
     // Prevent removal of last layer
-    if (m_layerList->count() <= 1) {
+    if (m_model->rowCount() <= 1) {
         QMessageBox::warning(this, "Cannot Remove",
                            "Cannot remove the last layer.");
         return;
     }
 
-    // Get the real layer name from UserRole
-    QString layerName = currentItem->data(Qt::UserRole).toString();
     int result = QMessageBox::question(this, "Remove Layer",
                                        QString("Remove layer '%1'?").arg(layerName),
                                        QMessageBox::Yes | QMessageBox::No);
 
     if (result == QMessageBox::Yes) {
-        // Remove layer from document (which will trigger refresh via signal)
-        if (m_document) {
-            m_document->removeLayer(layerName);
-        } else {
-            delete currentItem;
-        }
+        // Remove layer from document (the model drops the row via signal)
+        m_document->removeLayer(layerName);
     }
 }
 
 void LayersPanel::onRenameLayer()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem) {
+    QString oldName = currentLayerName();
+    if (oldName.isEmpty() || !m_document) {
         QMessageBox::information(this, "No Selection",
                                 "Please select a layer to rename.");
         return;
     }
 
-    QString oldName = currentItem->text();
     bool ok;
     QString newName = QInputDialog::getText(this,
                                            "Rename Layer",
@@ -306,42 +229,22 @@ void LayersPanel::onRenameLayer()
                                            &ok);
 
     if (ok && !newName.isEmpty() && newName != oldName) {
-        // Rename layer in document (which will trigger refresh via signal)
-        if (m_document) {
-            // Check if new name already exists
-            if (m_document->layers().contains(newName)) {
-                QMessageBox::warning(this, "Layer Exists",
-                                   "A layer with this name already exists.");
-                return;
-            }
-
-            m_document->renameLayer(oldName, newName);
-        } else {
-            // No document: rename in UI only
-            for (int i = 0; i < m_layerList->count(); ++i) {
-                if (m_layerList->item(i)->text() == newName) {
-                    QMessageBox::warning(this, "Layer Exists",
-                                       "A layer with this name already exists.");
-                    return;
-                }
-            }
-
-            currentItem->setText(newName);
-
-            if (m_activeLayer == oldName) {
-                m_activeLayer = newName;
-                emit activeLayerChanged(newName);
-            }
+        // Check if new name already exists
+        if (m_document->layers().contains(newName)) {
+            QMessageBox::warning(this, "Layer Exists",
+                               "A layer with this name already exists.");
+            return;
         }
+
+        // Rename layer in document (the model updates the row via signal)
+        m_document->renameLayer(oldName, newName);
     }
 }
 
 void LayersPanel::onLayerSelectionChanged()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (currentItem) {
-        // Get the real layer name from UserRole
-        QString layerName = currentItem->data(Qt::UserRole).toString();
+    QString layerName = currentLayerName();
+    if (!layerName.isEmpty()) {
         m_activeLayer = layerName;
 
         // Update document's active layer
@@ -353,66 +256,43 @@ void LayersPanel::onLayerSelectionChanged()
     }
 }
 
-void LayersPanel::onLayerItemChanged(QListWidgetItem* item)
-{
-    if (item) {
-        bool visible = (item->checkState() == Qt::Checked);
-        // Get the real layer name from UserRole (not the display text with object count)
-        QString layerName = item->data(Qt::UserRole).toString();
-
-        // Update layer visibility in document
-        if (m_document) {
-            m_document->setLayerVisible(layerName, visible);
-        }
-
-        emit layerVisibilityChanged(layerName, visible);
-    }
-}
-
 void LayersPanel::onChangeColor()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem) {
+    QString layerName = currentLayerName();
+    if (layerName.isEmpty() || !m_document) {
         QMessageBox::information(this, "No Selection",
                                 "Please select a layer to change color.");
         return;
     }
 
-    // Get the real layer name from UserRole
-    QString layerName = currentItem->data(Qt::UserRole).toString();
-    QColor currentColor = m_document ? m_document->layerColor(layerName) : Qt::black;
-
-    QColor newColor = QColorDialog::getColor(currentColor, this, "Choose Layer Color");
-    if (newColor.isValid() && m_document) {
+    QColor newColor = QColorDialog::getColor(m_document->layerColor(layerName), this, "Choose Layer Color");
+    if (newColor.isValid()) {
         m_document->setLayerColor(layerName, newColor);
-        refreshLayers();
     }
 }
 
-void LayersPanel::onLayerDoubleClicked(QListWidgetItem* item)
+void LayersPanel::onLayerDoubleClicked(const QModelIndex& index)
 {
-    if (item) {
-        // Get the real layer name from UserRole
-        QString layerName = item->data(Qt::UserRole).toString();
-        QColor currentColor = m_document ? m_document->layerColor(layerName) : Qt::black;
-
-        QColor newColor = QColorDialog::getColor(currentColor, this, "Choose Layer Color");
-        if (newColor.isValid() && m_document) {
-            m_document->setLayerColor(layerName, newColor);
-            refreshLayers();
-        }
+    QString layerName = m_model->layerAt(index);
+    if (layerName.isEmpty() || !m_document) {
+        return;
+    }
+
+    QColor newColor = QColorDialog::getColor(m_document->layerColor(layerName), this, "Choose Layer Color");
+    if (newColor.isValid()) {
+        m_document->setLayerColor(layerName, newColor);
     }
 }
 
 void LayersPanel::onLayerContextMenu(const QPoint& pos)
 {
-    QListWidgetItem* item = m_layerList->itemAt(pos);
-    if (!item || !m_document) {
+    QModelIndex index = m_layerList->indexAt(pos);
+    if (!index.isValid() || !m_document) {
         return;
     }
 
-    QString layerName = item->data(Qt::UserRole).toString();
-    bool isLocked = item->data(Qt::UserRole + 1).toBool();
+    QString layerName = m_model->layerAt(index);
+    bool isLocked = index.data(LayersModel::LayerLockedRole).toBool();
 
     QMenu contextMenu(this);
 
@@ -428,20 +308,18 @@ void LayersPanel::onLayerContextMenu(const QPoint& pos)
 
     // Lock/Unlock toggle
     QAction* lockAction = contextMenu.addAction(isLocked ? "Unlock Layer" : "Lock Layer");
-    connect(lockAction, &QAction::triggered, this, [this, item, layerName, isLocked]() {
+    connect(lockAction, &QAction::triggered, this, [this, layerName, isLocked]() {
         if (m_document) {
             m_document->setLayerLocked(layerName, !isLocked);
             emit layerLockChanged(layerName, !isLocked);
-            refreshLayers();
         }
     });
 
     contextMenu.addSeparator();
 
     // Merge Down action
-    int currentRow = m_layerList->row(item);
     QAction* mergeDownAction = contextMenu.addAction("Merge Down");
-    mergeDownAction->setEnabled(currentRow < m_layerList->count() - 1);
+    mergeDownAction->setEnabled(index.row() < m_model->rowCount() - 1);
     connect(mergeDownAction, &QAction::triggered, this, &LayersPanel::onMergeDown);
 
     // Duplicate Layer action
@@ -454,25 +332,24 @@ void LayersPanel::onLayerContextMenu(const QPoint& pos)
     QAction* selectAllAction = contextMenu.addAction("Select All Objects");
     connect(selectAllAction, &QAction::triggered, this, &LayersPanel::onSelectAllObjects);
 
-    contextMenu.exec(m_layerList->mapToGlobal(pos));
+    contextMenu.exec(m_layerList->viewport()->mapToGlobal(pos));
 }
 
 void LayersPanel::onMergeDown()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem || !m_document) {
+    QModelIndex currentIndex = m_layerList->currentIndex();
+    if (!currentIndex.isValid() || !m_document) {
         return;
     }
 
-    int currentRow = m_layerList->row(currentItem);
-    if (currentRow >= m_layerList->count() - 1) {
+    int currentRow = currentIndex.row();
+    if (currentRow >= m_model->rowCount() - 1) {
         QMessageBox::information(this, "Cannot Merge", "Cannot merge the bottom layer.");
         return;
     }
 
-    QString currentLayerName = currentItem->data(Qt::UserRole).toString();
-    QListWidgetItem* nextItem = m_layerList->item(currentRow + 1);
-    QString nextLayerName = nextItem->data(Qt::UserRole).toString();
+    QString currentLayerName = m_model->layerAt(currentIndex);
+    QString nextLayerName = m_model->layerAt(m_model->index(currentRow + 1));
 
     QMessageBox::StandardButton reply = QMessageBox::question(
         this,
@@ -484,24 +361,25 @@ void LayersPanel::onMergeDown()
     if (reply == QMessageBox::Yes) {
         // Move all objects from current layer to next layer
         auto objects = m_document->objectsOnLayer(currentLayerName);
-        for (auto* obj : objects) {
-            obj->setLayer(nextLayerName);
+        {
+            Document::ChangeBatch batch(m_document);
+            for (auto* obj : objects) {
+                obj->setLayer(nextLayerName);
+            }
         }
 
         // Remove the current layer
         m_document->removeLayer(currentLayerName);
-        refreshLayers();
     }
 }
 
 void LayersPanel::onDuplicateLayer()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem || !m_document) {
+    QString layerName = currentLayerName();
+    if (layerName.isEmpty() || !m_document) {
         return;
     }
 
-    QString layerName = currentItem->data(Qt::UserRole).toString();
     QString newLayerName = layerName + " Copy";
 
     // Ensure unique name
@@ -516,18 +394,15 @@ void LayersPanel::onDuplicateLayer()
 
     // Note: Objects are not duplicated, only the layer itself
     // If you want to duplicate objects too, you'd need to implement that here
-
-    refreshLayers();
 }
 
 void LayersPanel::onSelectAllObjects()
 {
-    QListWidgetItem* currentItem = m_layerList->currentItem();
-    if (!currentItem || !m_document) {
+    QString layerName = currentLayerName();
+    if (layerName.isEmpty() || !m_document) {
         return;
     }
 
-    QString layerName = currentItem->data(Qt::UserRole).toString();
     QList<Geometry::GeometryObject*> layerObjects = m_document->objectsOnLayer(layerName);
 
     if (layerObjects.isEmpty()) {
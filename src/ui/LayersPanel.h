@@ -9,7 +9,7 @@
 
 #include <QWidget>
 #include <QVBoxLayout>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QString>
 
@@ -20,12 +20,13 @@ class Document;
 
 namespace UI {
 
+class LayersModel;
+
 /**
  * LayersPanel provides layer management:
  * - List of layers with visibility toggles
  * - Active layer selection
  * - Add, remove, rename layers
- * - Layer reordering (z-order)
  * - Lock/unlock layers
  */
 class LayersPanel : public QWidget
@@ -54,8 +55,7 @@ private slots:
     void onRenameLayer();
     void onChangeColor();
     void onLayerSelectionChanged();
-    void onLayerItemChanged(QListWidgetItem* item);
-    void onLayerDoubleClicked(QListWidgetItem* item);
+    void onLayerDoubleClicked(const QModelIndex& index);
     void onLayerContextMenu(const QPoint& pos);
     void onMergeDown();
     void onDuplicateLayer();
@@ -64,11 +64,13 @@ private slots:
 private:
     // UI setup
     void setupUi();
-    void updateLayerList();
+    QString currentLayerName() const;
+    void selectLayer(const QString& layerName);
 
     // Private members
     QVBoxLayout* m_layout;
-    QListWidget* m_layerList;
+    LayersModel* m_model;
+    QListView* m_layerList;
     QPushButton* m_addButton;
     QPushButton* m_removeButton;
     QPushButton* m_renameButton;
@@ -79,6 +79,13 @@ MainWindow::MainWindow(QWidget* parent)
     setupUi();
     loadSettings();
 
+    // Keep curve evaluation precision in sync with preferences
+    connect(&SettingsManager::instance(), &SettingsManager::editorSettingsChanged, this, []() {
+        EditorSettings editor = SettingsManager::instance().editor();
+        Geometry::CurveSegment::setDefaultTolerance(editor.curveLengthTolerance);
+        Geometry::CurveSegment::setDefaultFlatteningTolerance(editor.curveFlatteningTolerance);
+    });
+
     // Connect to application
     Application* app = Application::instance();
     connect(app, &Application::projectChanged, this, &MainWindow::onProjectChanged);
@@ -97,9 +104,7 @@ MainWindow::MainWindow(QWidget* parent)
     // Connect ObjectsPanel signals
     connect(m_objectsPanel, &ObjectsPanel::objectSelected, this, [this](Geometry::GeometryObject* obj) {
         if (m_canvas->document()) {
-            m_canvas->document()->clearSelection();
-            obj->setSelected(true);
-            m_canvas->update();
+            m_canvas->document()->setSelectedObjects(QList<Geometry::GeometryObject*>() << obj);
         }
     });
     connect(m_objectsPanel, &ObjectsPanel::zoomToObject, m_canvas, &Canvas::zoomToObject);
@@ -267,6 +272,9 @@ void MainWindow::setupMenuBar()
     viewMenu->addSeparator();
     viewMenu->addAction(tr("Toggle &Grid"), this, &MainWindow::onViewToggleGrid);
     viewMenu->addAction(tr("Toggle &Snap to Grid"), this, &MainWindow::onViewToggleSnap);
+    viewMenu->addSeparator();
+    viewMenu->addAction(tr("Toggle &Render Statistics"), this, &MainWindow::onViewToggleRenderStats);
+    viewMenu->addAction(tr("Toggle Self-&Intersection Markers"), this, &MainWindow::onViewToggleSelfIntersections);
 
     // Draw menu (placeholder)
     menuBar()->addMenu(tr("&Draw"));
@@ -554,6 +562,10 @@ void MainWindow::loadSettings()
     restoreGeometry(settings.value("mainWindow/geometry").toByteArray());
     restoreState(settings.value("mainWindow/state").toByteArray());
 
+    // Curve evaluation precision
+    Geometry::CurveSegment::setDefaultTolerance(SettingsManager::instance().editor().curveLengthTolerance);
+    Geometry::CurveSegment::setDefaultFlatteningTolerance(SettingsManager::instance().editor().curveFlatteningTolerance);
+
     // Load auto-save settings
     if (m_autoSaveManager) {
         SettingsManager& settingsManager = SettingsManager::instance();
@@ -745,6 +757,7 @@ void MainWindow::onFileExportSVG()
     statusBar()->showMessage(tr("Exporting to SVG..."));
 
     IO::SVGFormat svgFormat;
+    svgFormat.setFlatteningTolerance(SettingsManager::instance().fileIO().exportFlatteningTolerance);
     if (svgFormat.exportFile(filepath, document)) {
         statusBar()->showMessage(tr("Exported to SVG: %1").arg(filepath), 3000);
     } else {
@@ -783,6 +796,7 @@ void MainWindow::onFileExportDXF()
     statusBar()->showMessage(tr("Exporting to DXF..."));
 
     IO::DXFFormat dxfFormat;
+    dxfFormat.setFlatteningTolerance(SettingsManager::instance().fileIO().exportFlatteningTolerance);
     if (dxfFormat.exportFile(filepath, document)) {
         statusBar()->showMessage(tr("Exported to DXF: %1").arg(filepath), 3000);
     } else {
@@ -821,6 +835,7 @@ void MainWindow::onFileExportPDF()
     statusBar()->showMessage(tr("Exporting to PDF..."));
 
     IO::PDFFormat pdfFormat;
+    pdfFormat.setFlatteningTolerance(SettingsManager::instance().fileIO().exportFlatteningTolerance);
     if (pdfFormat.exportFile(filepath, document)) {
         statusBar()->showMessage(tr("Exported to PDF: %1").arg(filepath), 3000);
     } else {
@@ -914,6 +929,24 @@ void MainWindow::onViewToggleSnap()
     }
 }
 
+void MainWindow::onViewToggleRenderStats()
+{
+    if (m_canvas) {
+        bool visible = m_canvas->renderStatsVisible();
+        m_canvas->setRenderStatsVisible(!visible);
+        statusBar()->showMessage(tr("Render statistics %1").arg(!visible ? tr("shown") : tr("hidden")), 2000);
+    }
+}
+
+void MainWindow::onViewToggleSelfIntersections()
+{
+    if (m_canvas) {
+        bool visible = m_canvas->selfIntersectionsVisible();
+        m_canvas->setSelfIntersectionsVisible(!visible);
+        statusBar()->showMessage(tr("Self-intersection markers %1").arg(!visible ? tr("shown") : tr("hidden")), 2000);
+    }
+}
+
 // Edit menu slots
 void MainWindow::onEditDelete()
 {
@@ -87,6 +87,8 @@ private slots:
     void onViewZoomActual();
     void onViewToggleGrid();
     void onViewToggleSnap();
+    void onViewToggleRenderStats();
+    void onViewToggleSelfIntersections();
 
     // Modify menu
     void onModifyRotate();
@@ -0,0 +1,345 @@
+/**
+ * ObjectsModel.cpp
+ *
+ * Implementation of ObjectsModel
+ */
+
+#include "ObjectsModel.h"
+#include "core/Document.h"
+#include "geometry/GeometryObject.h"
+#include "geometry/Polyline.h"
+#include "geometry/Notch.h"
+#include "geometry/MatchPoint.h"
+#include <QColor>
+#include <algorithm>
+#include <functional>
+
+namespace PatternCAD {
+namespace UI {
+
+ObjectsModel::ObjectsModel(QObject* parent)
+    : QAbstractItemModel(parent)
+    , m_document(nullptr)
+    , m_rowsValid(true)
+{
+}
+
+ObjectsModel::~ObjectsModel()
+{
+}
+
+void ObjectsModel::setDocument(Document* document)
+{
+    if (m_document) {
+        disconnect(m_document, nullptr, this, nullptr);
+    }
+
+    m_document = document;
+
+    if (m_document) {
+        connect(m_document, &Document::objectAdded, this, &ObjectsModel::onObjectAdded);
+        connect(m_document, &Document::objectsRemoved, this, &ObjectsModel::onObjectsRemoved);
+        connect(m_document, &Document::objectsChanged, this,
+                [this](const QList<Geometry::GeometryObject*>& objects) {
+            onObjectsChanged(objects);
+        });
+        connect(m_document, &Document::cleared, this, &ObjectsModel::reload);
+        connect(m_document, &QObject::destroyed, this, [this]() {
+            m_document = nullptr;
+            reload();
+        });
+    }
+
+    reload();
+}
+
+void ObjectsModel::reload()
+{
+    beginResetModel();
+    m_objects = m_document ? m_document->objects() : QList<Geometry::GeometryObject*>();
+    m_rows.clear();
+    m_rowsValid = false;
+    m_fetchedChildren.clear();
+    endResetModel();
+}
+
+Geometry::GeometryObject* ObjectsModel::objectAt(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return nullptr;
+    }
+    if (index.internalPointer()) {
+        return static_cast<Geometry::GeometryObject*>(index.internalPointer());
+    }
+    return (index.row() < m_objects.size()) ? m_objects[index.row()] : nullptr;
+}
+
+QModelIndex ObjectsModel::indexOf(Geometry::GeometryObject* object) const
+{
+    int row = rowOf(object);
+    return (row >= 0) ? createIndex(row, NameColumn, nullptr) : QModelIndex();
+}
+
+QModelIndex ObjectsModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (row < 0 || column < 0 || column >= ColumnCount) {
+        return QModelIndex();
+    }
+
+    if (!parent.isValid()) {
+        return (row < m_objects.size()) ? createIndex(row, column, nullptr) : QModelIndex();
+    }
+
+    // Children carry their parent object; only top-level rows have children
+    if (parent.internalPointer()) {
+        return QModelIndex();
+    }
+    Geometry::GeometryObject* object = objectAt(parent);
+    if (!object || row >= m_fetchedChildren.value(object, 0)) {
+        return QModelIndex();
+    }
+    return createIndex(row, column, object);
+}
+
+QModelIndex ObjectsModel::parent(const QModelIndex& child) const
+{
+    if (!child.isValid() || !child.internalPointer()) {
+        return QModelIndex();
+    }
+    return indexOf(static_cast<Geometry::GeometryObject*>(child.internalPointer()));
+}
+
+int ObjectsModel::rowCount(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return m_objects.size();
+    }
+    if (parent.column() != NameColumn || parent.internalPointer()) {
+        return 0;
+    }
+    return m_fetchedChildren.value(objectAt(parent), 0);
+}
+
+int ObjectsModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return ColumnCount;
+}
+
+bool ObjectsModel::hasChildren(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return !m_objects.isEmpty();
+    }
+    if (parent.column() != NameColumn || parent.internalPointer()) {
+        return false;
+    }
+    return childCountOf(objectAt(parent)) > 0;
+}
+
+bool ObjectsModel::canFetchMore(const QModelIndex& parent) const
+{
+    if (!parent.isValid() || parent.internalPointer()) {
+        return false;
+    }
+    Geometry::GeometryObject* object = objectAt(parent);
+    return object && !m_fetchedChildren.contains(object) && childCountOf(object) > 0;
+}
+
+void ObjectsModel::fetchMore(const QModelIndex& parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    Geometry::GeometryObject* object = objectAt(parent);
+    int count = childCountOf(object);
+    beginInsertRows(parent.sibling(parent.row(), NameColumn), 0, count - 1);
+    m_fetchedChildren.insert(object, count);
+    endInsertRows();
+}
+
+QVariant ObjectsModel::data(const QModelIndex& index, int role) const
+{
+    Geometry::GeometryObject* object = objectAt(index);
+    if (!object) {
+        return QVariant();
+    }
+
+    if (index.internalPointer()) {
+        return (role == Qt::DisplayRole) ? childData(object, index.row(), index.column()) : QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case NameColumn: {
+            QString name = object->name();
+            if (name.isEmpty()) {
+                name = QString("%1 #%2").arg(object->typeName()).arg(object->id());
+            }
+            return name;
+        }
+        case TypeColumn:
+            return object->typeName();
+        case LayerColumn:
+            return object->layer();
+        }
+        break;
+    case Qt::ForegroundRole:
+        // Visual feedback for visibility
+        if (!object->isVisible()) {
+            return QColor(Qt::gray);
+        }
+        break;
+    }
+    return QVariant();
+}
+
+QVariant ObjectsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+    case NameColumn:
+        return tr("Name");
+    case TypeColumn:
+        return tr("Type");
+    case LayerColumn:
+        return tr("Layer");
+    }
+    return QVariant();
+}
+
+void ObjectsModel::onObjectAdded(Geometry::GeometryObject* object)
+{
+    // The document appends new objects to the top of the z-order
+    int row = m_objects.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_objects.append(object);
+    if (m_rowsValid) {
+        m_rows.insert(object, row);
+    }
+    endInsertRows();
+}
+
+void ObjectsModel::onObjectsRemoved(const QList<Geometry::GeometryObject*>& objects)
+{
+    // Rows are looked up once for the whole batch and removed bottom to
+    // top, so rows still to be removed keep their numbers and each
+    // contiguous run is announced as one range
+    QVector<int> rows;
+    rows.reserve(objects.size());
+    for (Geometry::GeometryObject* object : objects) {
+        int row = rowOf(object);
+        if (row >= 0) {
+            rows.append(row);
+        }
+    }
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+
+    for (int i = 0; i < rows.size();) {
+        int last = rows[i];
+        int first = last;
+        while (++i < rows.size() && rows[i] == first - 1) {
+            first = rows[i];
+        }
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row) {
+            m_fetchedChildren.remove(m_objects[row]);
+        }
+        m_objects.remove(first, last - first + 1);
+        m_rows.clear();
+        m_rowsValid = false;
+        endRemoveRows();
+    }
+}
+
+void ObjectsModel::onObjectsChanged(const QList<Geometry::GeometryObject*>& objects)
+{
+    for (Geometry::GeometryObject* object : objects) {
+        int row = rowOf(object);
+        if (row < 0) {
+            continue;
+        }
+
+        QModelIndex parent = createIndex(row, NameColumn, nullptr);
+        emit dataChanged(parent, createIndex(row, ColumnCount - 1, nullptr));
+
+        // Keep published children in step with the polyline
+        auto fetched = m_fetchedChildren.find(object);
+        if (fetched == m_fetchedChildren.end()) {
+            continue;
+        }
+        int oldCount = fetched.value();
+        int newCount = childCountOf(object);
+        if (newCount < oldCount) {
+            beginRemoveRows(parent, newCount, oldCount - 1);
+            fetched.value() = newCount;
+            endRemoveRows();
+        } else if (newCount > oldCount) {
+            beginInsertRows(parent, oldCount, newCount - 1);
+            fetched.value() = newCount;
+            endInsertRows();
+        }
+        if (qMin(oldCount, newCount) > 0) {
+            emit dataChanged(index(0, NameColumn, parent),
+                             index(qMin(oldCount, newCount) - 1, ColumnCount - 1, parent));
+        }
+    }
+}
+
+int ObjectsModel::rowOf(Geometry::GeometryObject* object) const
+{
+    if (!m_rowsValid) {
+        m_rows.clear();
+        m_rows.reserve(m_objects.size());
+        for (int row = 0; row < m_objects.size(); ++row) {
+            m_rows.insert(m_objects[row], row);
+        }
+        m_rowsValid = true;
+    }
+    return m_rows.value(object, -1);
+}
+
+int ObjectsModel::childCountOf(Geometry::GeometryObject* object)
+{
+    auto* polyline = qobject_cast<Geometry::Polyline*>(object);
+    return polyline ? polyline->notchCount() + polyline->matchPointCount() : 0;
+}
+
+QVariant ObjectsModel::childData(Geometry::GeometryObject* object, int row, int column) const
+{
+    auto* polyline = qobject_cast<Geometry::Polyline*>(object);
+    if (!polyline) {
+        return QVariant();
+    }
+
+    // Notches first, then match points
+    if (row < polyline->notchCount()) {
+        switch (column) {
+        case NameColumn:
+            return tr("Notch %1").arg(row + 1);
+        case TypeColumn:
+            return tr("Notch");
+        }
+        return QVariant();
+    }
+
+    row -= polyline->notchCount();
+    if (row < polyline->matchPointCount()) {
+        switch (column) {
+        case NameColumn:
+            return polyline->matchPoints()[row]->label();
+        case TypeColumn:
+            return tr("Match Point");
+        }
+    }
+    return QVariant();
+}
+
+} // namespace UI
+} // namespace PatternCAD
@@ -0,0 +1,87 @@
+/**
+ * ObjectsModel.h
+ *
+ * Item model over the objects of a document
+ */
+
+#ifndef PATTERNCAD_OBJECTSMODEL_H
+#define PATTERNCAD_OBJECTSMODEL_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QList>
+
+namespace PatternCAD {
+
+class Document;
+
+namespace Geometry {
+    class GeometryObject;
+}
+
+namespace UI {
+
+/**
+ * ObjectsModel exposes the document's objects as a tree:
+ * - Top-level rows are the objects in z-order, columns name, type, layer
+ * - Polylines have their notches and match points as children, populated
+ *   lazily (fetchMore) the first time the row is expanded
+ * - Document signals map to row insertions, removals and dataChanged,
+ *   so views never rebuild from scratch
+ */
+class ObjectsModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        NameColumn = 0,
+        TypeColumn,
+        LayerColumn,
+        ColumnCount
+    };
+
+    explicit ObjectsModel(QObject* parent = nullptr);
+    ~ObjectsModel();
+
+    void setDocument(Document* document);
+
+    // Object of a row; for child rows, the polyline they belong to
+    Geometry::GeometryObject* objectAt(const QModelIndex& index) const;
+    QModelIndex indexOf(Geometry::GeometryObject* object) const;
+
+    // QAbstractItemModel
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    void reload();
+    void onObjectAdded(Geometry::GeometryObject* object);
+    void onObjectsRemoved(const QList<Geometry::GeometryObject*>& objects);
+    void onObjectsChanged(const QList<Geometry::GeometryObject*>& objects);
+    int rowOf(Geometry::GeometryObject* object) const;
+    static int childCountOf(Geometry::GeometryObject* object);
+    QVariant childData(Geometry::GeometryObject* object, int row, int column) const;
+
+    Document* m_document;
+    QList<Geometry::GeometryObject*> m_objects;
+
+    // Row lookup, rebuilt lazily after removals shift rows
+    mutable QHash<Geometry::GeometryObject*, int> m_rows;
+    mutable bool m_rowsValid;
+
+    // Child rows published to views, per fetched object
+    QHash<Geometry::GeometryObject*, int> m_fetchedChildren;
+};
+
+} // namespace UI
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_OBJECTSMODEL_H
@@ -8,7 +8,7 @@
 #define PATTERNCAD_OBJECTSPANEL_H
 
 #include <QDockWidget>
-#include <QTreeWidget>
+#include <QTreeView>
 
 namespace PatternCAD {
 
@@ -20,6 +20,8 @@ namespace Geometry {
 
 namespace UI {
 
+class ObjectsModel;
+
 class ObjectsPanel : public QDockWidget
 {
     Q_OBJECT
@@ -38,15 +40,15 @@ signals:
     void zoomToObject(Geometry::GeometryObject* object);
 
 private slots:
-    void onItemClicked(QTreeWidgetItem* item, int column);
-    void onItemDoubleClicked(QTreeWidgetItem* item, int column);
+    void onItemClicked(const QModelIndex& index);
+    void onItemDoubleClicked(const QModelIndex& index);
 
 private:
     void setupUI();
-    void populateTree();
 
     Document* m_document;
-    QTreeWidget* m_tree;
+    ObjectsModel* m_model;
+    QTreeView* m_tree;
 };
 
 } // namespace UI
@@ -180,6 +180,27 @@ void PreferencesDialog::createEditorTab()
     canvasLayout->addRow("", m_antiAliasingCheck);
 
     layout->addWidget(canvasGroup);
+
+    // Curves group
+    QGroupBox* curvesGroup = new QGroupBox(tr("Curves"));
+    QFormLayout* curvesLayout = new QFormLayout(curvesGroup);
+
+    m_curveLengthToleranceSpinBox = new QDoubleSpinBox();
+    m_curveLengthToleranceSpinBox->setRange(0.0001, 1.0);
+    m_curveLengthToleranceSpinBox->setSuffix(tr(" mm"));
+    m_curveLengthToleranceSpinBox->setDecimals(4);
+    m_curveLengthToleranceSpinBox->setSingleStep(0.001);
+    curvesLayout->addRow(tr("Length Tolerance:"), m_curveLengthToleranceSpinBox);
+
+    m_curveFlatteningToleranceSpinBox = new QDoubleSpinBox();
+    m_curveFlatteningToleranceSpinBox->setRange(0.001, 5.0);
+    m_curveFlatteningToleranceSpinBox->setSuffix(tr(" mm"));
+    m_curveFlatteningToleranceSpinBox->setDecimals(3);
+    m_curveFlatteningToleranceSpinBox->setSingleStep(0.01);
+    m_curveFlatteningToleranceSpinBox->setToolTip(tr("Maximum deviation of curve approximations on screen and in seam allowances"));
+    curvesLayout->addRow(tr("Display Flattening:"), m_curveFlatteningToleranceSpinBox);
+
+    layout->addWidget(curvesGroup);
     layout->addStretch();
 
     m_tabWidget->addTab(editorTab, tr("Editor"));
@@ -250,6 +271,16 @@ void PreferencesDialog::createFileIOTab()
     m_compressNativeCheck = new QCheckBox(tr("Compress native files (.patterncad)"));
     formatLayout->addWidget(m_compressNativeCheck);
 
+    QFormLayout* exportLayout = new QFormLayout();
+    m_exportFlatteningToleranceSpinBox = new QDoubleSpinBox();
+    m_exportFlatteningToleranceSpinBox->setRange(0.0001, 1.0);
+    m_exportFlatteningToleranceSpinBox->setSuffix(tr(" mm"));
+    m_exportFlatteningToleranceSpinBox->setDecimals(4);
+    m_exportFlatteningToleranceSpinBox->setSingleStep(0.001);
+    m_exportFlatteningToleranceSpinBox->setToolTip(tr("Maximum deviation of curve approximations in exported files"));
+    exportLayout->addRow(tr("Export Flattening:"), m_exportFlatteningToleranceSpinBox);
+    formatLayout->addLayout(exportLayout);
+
     layout->addWidget(formatGroup);
     layout->addStretch();
 
@@ -324,6 +355,8 @@ void PreferencesDialog::loadSettings()
     m_canvasColor = editor.canvasBackgroundColor;
     updateColorButton(m_canvasColorButton, m_canvasColor);
     m_antiAliasingCheck->setChecked(editor.antiAliasing);
+    m_curveLengthToleranceSpinBox->setValue(editor.curveLengthTolerance);
+    m_curveFlatteningToleranceSpinBox->setValue(editor.curveFlatteningTolerance);
 
     // File I/O
     FileIOSettings fileIO = settings.fileIO();
@@ -335,6 +368,7 @@ void PreferencesDialog::loadSettings()
     onAutoSaveLocationChanged(fileIO.autoSaveLocation); // Update enabled state
     m_recentFilesCountSpinBox->setValue(fileIO.recentFilesCount);
     m_compressNativeCheck->setChecked(fileIO.compressNativeFormat);
+    m_exportFlatteningToleranceSpinBox->setValue(fileIO.exportFlatteningTolerance);
 
     // Advanced
     AdvancedSettings advanced = settings.advanced();
@@ -369,6 +403,8 @@ void PreferencesDialog::saveSettings()
     editor.selectionLineWidth = m_selectionLineWidthSpinBox->value();
     editor.canvasBackgroundColor = m_canvasColor;
     editor.antiAliasing = m_antiAliasingCheck->isChecked();
+    editor.curveLengthTolerance = m_curveLengthToleranceSpinBox->value();
+    editor.curveFlatteningTolerance = m_curveFlatteningToleranceSpinBox->value();
     settings.setEditor(editor);
 
     // File I/O
@@ -380,6 +416,7 @@ void PreferencesDialog::saveSettings()
     fileIO.autoSaveCustomDirectory = m_autoSaveCustomDirEdit->text();
     fileIO.recentFilesCount = m_recentFilesCountSpinBox->value();
     fileIO.compressNativeFormat = m_compressNativeCheck->isChecked();
+    fileIO.exportFlatteningTolerance = m_exportFlatteningToleranceSpinBox->value();
     settings.setFileIO(fileIO);
 
     // Advanced
@@ -81,6 +81,9 @@ private:
     QColor m_canvasColor;
     QCheckBox* m_antiAliasingCheck;
 
+    QDoubleSpinBox* m_curveLengthToleranceSpinBox;
+    QDoubleSpinBox* m_curveFlatteningToleranceSpinBox;
+
     // File I/O tab widgets
     QCheckBox* m_autoSaveCheck;
     QSpinBox* m_autoSaveIntervalSpinBox;
@@ -90,6 +93,7 @@ private:
     QPushButton* m_autoSaveCustomDirButton;
     QSpinBox* m_recentFilesCountSpinBox;
     QCheckBox* m_compressNativeCheck;
+    QDoubleSpinBox* m_exportFlatteningToleranceSpinBox;
 
     // Advanced tab widgets
     QSpinBox* m_undoHistoryLimitSpinBox;
@@ -15,6 +15,8 @@
 #include "core/Document.h"
 #include "core/Commands.h"
 #include <QScrollArea>
+#include <QSet>
+#include <algorithm>
 
 namespace PatternCAD {
 namespace UI {
@@ -162,10 +164,14 @@ void PropertiesPanel::setDocument(Document* document)
 
     // Connect to document signals
     if (m_document) {
-        connect(m_document, &Document::selectionChanged,
-                this, [this]() {
-            setSelectedObjects(m_document->selectedObjects());
-        });
+        // Selection deltas update the listed objects in place rather than
+        // pulling the whole selection on every change
+        connect(m_document, &Document::objectsSelected,
+                this, &PropertiesPanel::onObjectsSelected);
+        connect(m_document, &Document::objectsDeselected,
+                this, &PropertiesPanel::onObjectsDeselected);
+        connect(m_document, &Document::cleared,
+                this, &PropertiesPanel::clearSelection);
 
         // Update layer combo when layers change
         connect(m_document, &Document::layerAdded,
@@ -188,15 +194,59 @@ void PropertiesPanel::setDocument(Document* document)
 void PropertiesPanel::setSelectedObjects(const QList<Geometry::GeometryObject*>& objects)
 {
     m_selectedObjects = objects;
+    updateSelectionBounds();
     updateProperties();
 }
 
 void PropertiesPanel::clearSelection()
 {
     m_selectedObjects.clear();
+    m_selectionBounds = QRectF();
     updateProperties();
 }
 
+void PropertiesPanel::onObjectsSelected(const QList<Geometry::GeometryObject*>& objects)
+{
+    for (auto* obj : objects) {
+        m_selectedObjects.append(obj);
+        m_selectionBounds = m_selectionBounds.isNull() ? obj->boundingRect()
+                                                       : m_selectionBounds.united(obj->boundingRect());
+    }
+    updateProperties();
+}
+
+void PropertiesPanel::onObjectsDeselected(const QList<Geometry::GeometryObject*>& objects)
+{
+    // One pass over the list for the whole delta
+    QSet<Geometry::GeometryObject*> removed(objects.begin(), objects.end());
+    m_selectedObjects.erase(std::remove_if(m_selectedObjects.begin(), m_selectedObjects.end(),
+                                           [&removed](Geometry::GeometryObject* obj) {
+                                               return removed.contains(obj);
+                                           }),
+                            m_selectedObjects.end());
+
+    // The combined bounds only shrink if a deselected object reached
+    // their edge
+    for (auto* obj : objects) {
+        QRectF bounds = obj->boundingRect();
+        if (bounds.left() <= m_selectionBounds.left() || bounds.top() <= m_selectionBounds.top() ||
+            bounds.right() >= m_selectionBounds.right() || bounds.bottom() >= m_selectionBounds.bottom()) {
+            updateSelectionBounds();
+            break;
+        }
+    }
+    updateProperties();
+}
+
+void PropertiesPanel::updateSelectionBounds()
+{
+    m_selectionBounds = QRectF();
+    for (auto* obj : m_selectedObjects) {
+        QRectF bounds = obj->boundingRect();
+        m_selectionBounds = m_selectionBounds.isNull() ? bounds : m_selectionBounds.united(bounds);
+    }
+}
+
 void PropertiesPanel::updateProperties()
 {
     // Block signals while updating to avoid triggering onPropertyEdited
@@ -285,18 +335,9 @@ void PropertiesPanel::updateProperties()
         m_nameEdit->clear();
         m_nameEdit->setPlaceholderText("[Multiple objects]");
 
-        // Calculate combined bounding box
-        QRectF combinedBounds;
-        for (auto* obj : m_selectedObjects) {
-            QRectF bounds = obj->boundingRect();
-            if (combinedBounds.isNull()) {
-                combinedBounds = bounds;
-            } else {
-                combinedBounds = combinedBounds.united(bounds);
-            }
-        }
-        m_widthEdit->setValue(combinedBounds.width());
-        m_heightEdit->setValue(combinedBounds.height());
+        // Combined bounding box, kept up to date with the selection deltas
+        m_widthEdit->setValue(m_selectionBounds.width());
+        m_heightEdit->setValue(m_selectionBounds.height());
 
         // Show first object's properties for layer
         if (!m_selectedObjects.isEmpty()) {
@@ -17,6 +17,7 @@
 #include <QPushButton>
 #include <QCheckBox>
 #include <QList>
+#include <QRectF>
 
 namespace PatternCAD {
 
@@ -57,6 +58,8 @@ signals:
 
 private slots:
     void onPropertyEdited();
+    void onObjectsSelected(const QList<Geometry::GeometryObject*>& objects);
+    void onObjectsDeselected(const QList<Geometry::GeometryObject*>& objects);
 
 private:
     // UI setup
@@ -64,6 +67,7 @@ private:
     void updateProperties();
     void createCommonProperties();
     void createGeometryProperties();
+    void updateSelectionBounds();
 
     // Private members
     QVBoxLayout* m_mainLayout;
@@ -71,7 +75,8 @@ private:
     QWidget* m_formWidget;
     QLabel* m_titleLabel;
     Document* m_document;
-    QList<Geometry::GeometryObject*> m_selectedObjects;
+    QList<Geometry::GeometryObject*> m_selectedObjects;  // In selection order
+    QRectF m_selectionBounds;  // Combined bounding box of m_selectedObjects
 
     // Property widgets
     QLineEdit* m_nameEdit;
@@ -0,0 +1,215 @@
+/**
+ * RenderStats.cpp
+ *
+ * Implementation of RenderStats
+ */
+
+#include "RenderStats.h"
+#include <cstring>
+
+namespace PatternCAD {
+namespace UI {
+
+namespace {
+    double toMs(qint64 nanoseconds)
+    {
+        return nanoseconds / 1.0e6;
+    }
+}
+
+RenderStats::RenderStats(int window)
+    : m_frames(qMax(1, window))
+    , m_next(0)
+    , m_count(0)
+    , m_current(emptyFrame())
+    , m_enabled(false)
+    , m_inFrame(false)
+{
+}
+
+RenderStats::Frame RenderStats::emptyFrame()
+{
+    Frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    return frame;
+}
+
+void RenderStats::setEnabled(bool enabled)
+{
+    if (enabled != m_enabled) {
+        m_enabled = enabled;
+        clear();
+    }
+}
+
+void RenderStats::clear()
+{
+    m_next = 0;
+    m_count = 0;
+    m_current = emptyFrame();
+    m_inFrame = false;
+}
+
+void RenderStats::beginFrame()
+{
+    if (!m_enabled) {
+        return;
+    }
+    m_current = emptyFrame();
+    m_frameTimer.start();
+    m_inFrame = true;
+}
+
+void RenderStats::endFrame()
+{
+    if (!m_enabled || !m_inFrame) {
+        return;
+    }
+    m_current.totalNs = m_frameTimer.nsecsElapsed();
+    m_frames[m_next] = m_current;
+    m_next = (m_next + 1) % m_frames.size();
+    m_count = qMin(m_count + 1, static_cast<int>(m_frames.size()));
+    m_inFrame = false;
+}
+
+const RenderStats::Frame& RenderStats::frameAt(int age) const
+{
+    int size = m_frames.size();
+    return m_frames[(m_next - 1 - age + 2 * size) % size];
+}
+
+RenderStats::Frame RenderStats::lastFrame() const
+{
+    return (m_count > 0) ? frameAt(0) : emptyFrame();
+}
+
+RenderStats::Frame RenderStats::totals() const
+{
+    Frame sum = emptyFrame();
+    for (int age = 0; age < m_count; ++age) {
+        const Frame& frame = frameAt(age);
+        sum.totalNs += frame.totalNs;
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            sum.phaseNs[phase] += frame.phaseNs[phase];
+        }
+        for (int counter = 0; counter < CounterCount; ++counter) {
+            sum.counters[counter] += frame.counters[counter];
+        }
+        for (int type = 0; type < ObjectTypeCount; ++type) {
+            sum.types[type].drawn += frame.types[type].drawn;
+            sum.types[type].culled += frame.types[type].culled;
+            sum.types[type].displayListHits += frame.types[type].displayListHits;
+            sum.types[type].displayListMisses += frame.types[type].displayListMisses;
+        }
+    }
+    return sum;
+}
+
+double RenderStats::averageFrameMs() const
+{
+    return (m_count > 0) ? toMs(totals().totalNs) / m_count : 0.0;
+}
+
+double RenderStats::maxFrameMs() const
+{
+    qint64 maxNs = 0;
+    for (int age = 0; age < m_count; ++age) {
+        maxNs = qMax(maxNs, frameAt(age).totalNs);
+    }
+    return toMs(maxNs);
+}
+
+double RenderStats::averagePhaseMs(Phase phase) const
+{
+    return (m_count > 0) ? toMs(totals().phaseNs[phase]) / m_count : 0.0;
+}
+
+double RenderStats::maxPhaseMs(Phase phase) const
+{
+    qint64 maxNs = 0;
+    for (int age = 0; age < m_count; ++age) {
+        maxNs = qMax(maxNs, frameAt(age).phaseNs[phase]);
+    }
+    return toMs(maxNs);
+}
+
+QStringList RenderStats::summary() const
+{
+    QStringList lines;
+    if (m_count == 0) {
+        lines << QString("No frames recorded");
+        return lines;
+    }
+
+    Frame sum = totals();
+    lines << QString("Frame  avg %1 ms  max %2 ms  (%3 frames)")
+                 .arg(averageFrameMs(), 0, 'f', 2).arg(maxFrameMs(), 0, 'f', 2).arg(m_count);
+    for (int phase = 0; phase < PhaseCount; ++phase) {
+        Phase p = static_cast<Phase>(phase);
+        lines << QString("  %1  avg %2 ms  max %3 ms").arg(phaseName(p), -12)
+                     .arg(averagePhaseMs(p), 0, 'f', 2).arg(maxPhaseMs(p), 0, 'f', 2);
+    }
+
+    // Counters are shown per frame, averaged over the window
+    auto perFrame = [this](int total) { return QString::number(double(total) / m_count, 'f', 1); };
+    lines << QString("Tiles  hit %1  miss %2  stand-in %3  outside view %4")
+                 .arg(perFrame(sum.counters[TileHits]), perFrame(sum.counters[TileMisses]),
+                      perFrame(sum.counters[TilePlaceholders]), perFrame(sum.counters[OutsideView]));
+    for (int type = 0; type < ObjectTypeCount; ++type) {
+        const TypeCounts& counts = sum.types[type];
+        if (counts.drawn + counts.culled + counts.displayListHits + counts.displayListMisses == 0) {
+            continue;
+        }
+        lines << QString("  %1  drawn %2  culled %3  lists hit %4  miss %5").arg(typeName(type), -12)
+                     .arg(perFrame(counts.drawn), perFrame(counts.culled),
+                          perFrame(counts.displayListHits), perFrame(counts.displayListMisses));
+    }
+    return lines;
+}
+
+QString RenderStats::phaseName(Phase phase)
+{
+    switch (phase) {
+    case BackgroundPhase:
+        return QString("Background");
+    case GridPhase:
+        return QString("Grid");
+    case TilesPhase:
+        return QString("Tiles");
+    case GeometryPhase:
+        return QString("Geometry");
+    case DimensionsPhase:
+        return QString("Dimensions");
+    case ToolOverlayPhase:
+        return QString("Tool overlay");
+    case PhaseCount:
+        break;
+    }
+    return QString();
+}
+
+QString RenderStats::typeName(int type)
+{
+    switch (static_cast<Geometry::ObjectType>(type)) {
+    case Geometry::ObjectType::Point:
+        return QString("Point");
+    case Geometry::ObjectType::Line:
+        return QString("Line");
+    case Geometry::ObjectType::Circle:
+        return QString("Circle");
+    case Geometry::ObjectType::Rectangle:
+        return QString("Rectangle");
+    case Geometry::ObjectType::CubicBezier:
+        return QString("Bezier");
+    case Geometry::ObjectType::Arc:
+        return QString("Arc");
+    case Geometry::ObjectType::Polyline:
+        return QString("Polyline");
+    case Geometry::ObjectType::Polygon:
+        return QString("Polygon");
+    }
+    return QString();
+}
+
+} // namespace UI
+} // namespace PatternCAD
@@ -0,0 +1,167 @@
+/**
+ * RenderStats.h
+ *
+ * Frame timing and draw counters for canvas rendering
+ */
+
+#ifndef PATTERNCAD_RENDERSTATS_H
+#define PATTERNCAD_RENDERSTATS_H
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "geometry/GeometryObject.h"
+
+// Diagnostic logging on the render path. Compiled out (arguments are not
+// evaluated) in release builds, where Qt defines QT_NO_DEBUG.
+#ifdef QT_NO_DEBUG
+#define PATTERNCAD_RENDER_LOG() while (false) qDebug()
+#else
+#define PATTERNCAD_RENDER_LOG() qDebug()
+#endif
+
+namespace PatternCAD {
+namespace UI {
+
+/**
+ * RenderStats collects per-frame render statistics over a rolling window:
+ * - Time spent in each paint phase, measured with ScopedTimer
+ * - Objects drawn and culled, per object type
+ * - Display list cache hits and misses per object type, tile cache hits
+ *   and misses per frame
+ * Collection is off by default; while disabled the timers and counters
+ * return immediately.
+ */
+class RenderStats
+{
+public:
+    enum Phase {
+        BackgroundPhase = 0,
+        GridPhase,
+        TilesPhase,
+        GeometryPhase,
+        DimensionsPhase,
+        ToolOverlayPhase,
+        PhaseCount
+    };
+
+    enum Counter {
+        TileHits = 0,
+        TileMisses,
+        TilePlaceholders,
+        OutsideView,  // Objects skipped by the spatial index query
+        CounterCount
+    };
+
+    static constexpr int ObjectTypeCount = static_cast<int>(Geometry::ObjectType::Polygon) + 1;
+    static constexpr int DefaultWindow = 120;
+
+    struct TypeCounts {
+        int drawn;
+        int culled;
+        int displayListHits;
+        int displayListMisses;
+    };
+
+    struct Frame {
+        qint64 totalNs;
+        qint64 phaseNs[PhaseCount];
+        int counters[CounterCount];
+        TypeCounts types[ObjectTypeCount];
+    };
+
+    // Adds the lifetime of the timer to a phase of the current frame
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(RenderStats& stats, Phase phase)
+            : m_stats(stats.isEnabled() ? &stats : nullptr), m_phase(phase) {
+            if (m_stats) {
+                m_timer.start();
+            }
+        }
+        ~ScopedTimer() {
+            if (m_stats) {
+                m_stats->addPhaseTime(m_phase, m_timer.nsecsElapsed());
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        RenderStats* m_stats;
+        Phase m_phase;
+        QElapsedTimer m_timer;
+    };
+
+    explicit RenderStats(int window = DefaultWindow);
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    void clear();
+
+    // Frame boundaries; counters and phase times go to the open frame
+    void beginFrame();
+    void endFrame();
+
+    void addPhaseTime(Phase phase, qint64 nanoseconds) {
+        if (m_enabled) {
+            m_current.phaseNs[phase] += nanoseconds;
+        }
+    }
+    void count(Counter counter, int amount = 1) {
+        if (m_enabled) {
+            m_current.counters[counter] += amount;
+        }
+    }
+    void countDrawn(Geometry::ObjectType type) {
+        if (m_enabled) {
+            ++m_current.types[static_cast<int>(type)].drawn;
+        }
+    }
+    void countCulled(Geometry::ObjectType type) {
+        if (m_enabled) {
+            ++m_current.types[static_cast<int>(type)].culled;
+        }
+    }
+    void countDisplayList(Geometry::ObjectType type, bool hit) {
+        if (m_enabled) {
+            TypeCounts& counts = m_current.types[static_cast<int>(type)];
+            ++(hit ? counts.displayListHits : counts.displayListMisses);
+        }
+    }
+
+    // Rolling statistics over the completed frames in the window
+    int frameCount() const { return m_count; }
+    Frame lastFrame() const;
+    Frame totals() const;  // Sums over the window
+    double averageFrameMs() const;
+    double maxFrameMs() const;
+    double averagePhaseMs(Phase phase) const;
+    double maxPhaseMs(Phase phase) const;
+
+    // Text lines for an on-screen overlay
+    QStringList summary() const;
+
+    static QString phaseName(Phase phase);
+    static QString typeName(int type);
+
+private:
+    static Frame emptyFrame();
+    const Frame& frameAt(int age) const;  // 0 = most recent
+
+    QVector<Frame> m_frames;  // Ring buffer
+    int m_next;
+    int m_count;
+    Frame m_current;
+    QElapsedTimer m_frameTimer;
+    bool m_enabled;
+    bool m_inFrame;
+};
+
+} // namespace UI
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_RENDERSTATS_H
@@ -0,0 +1,227 @@
+/**
+ * TileCache.cpp
+ *
+ * Implementation of TileCache
+ */
+
+#include "TileCache.h"
+#include <QPair>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace PatternCAD {
+namespace UI {
+
+TileCache::TileCache(int maxTiles)
+    : m_maxTiles(maxTiles)
+    , m_useCounter(0)
+    , m_frameStart(0)
+    , m_ticketCounter(0)
+{
+}
+
+QRectF TileCache::tileRect(double scale, int x, int y)
+{
+    double size = TileSize / scale;
+    return QRectF(x * size, y * size, size, size);
+}
+
+QRect TileCache::tileRange(double scale, const QRectF& sceneRect)
+{
+    double size = TileSize / scale;
+    int left = static_cast<int>(std::floor(sceneRect.left() / size));
+    int top = static_cast<int>(std::floor(sceneRect.top() / size));
+    int right = static_cast<int>(std::floor(sceneRect.right() / size));
+    int bottom = static_cast<int>(std::floor(sceneRect.bottom() / size));
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+bool TileCache::find(const Key& key, QImage* image, bool* stale)
+{
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end()) {
+        return false;
+    }
+
+    it->lastUsed = ++m_useCounter;
+    if (image) {
+        *image = it->image;
+    }
+    if (stale) {
+        *stale = it->stale;
+    }
+    return true;
+}
+
+bool TileCache::peek(const Key& key, QImage* image) const
+{
+    auto it = m_tiles.constFind(key);
+    if (it == m_tiles.constEnd()) {
+        return false;
+    }
+    if (image) {
+        *image = it->image;
+    }
+    return true;
+}
+
+void TileCache::insert(const Key& key, const QImage& image)
+{
+    Tile tile;
+    tile.image = image;
+    tile.lastUsed = ++m_useCounter;
+    tile.stale = false;
+    m_tiles.insert(key, tile);
+}
+
+quint64 TileCache::markPending(const Key& key)
+{
+    quint64 ticket = ++m_ticketCounter;
+    m_pending.insert(key, ticket);
+    return ticket;
+}
+
+bool TileCache::completePending(const Key& key, quint64 ticket, const QImage& image)
+{
+    auto it = m_pending.find(key);
+    if (it == m_pending.end() || it.value() != ticket) {
+        return false;
+    }
+
+    m_pending.erase(it);
+    insert(key, image);
+    return true;
+}
+
+void TileCache::clearPending()
+{
+    m_pending.clear();
+}
+
+QVector<double> TileCache::scales(const QString& layer, double closestTo) const
+{
+    QVector<double> result;
+    for (auto it = m_tiles.constBegin(); it != m_tiles.constEnd(); ++it) {
+        if (it.key().layer == layer && !result.contains(it.key().scale)) {
+            result.append(it.key().scale);
+        }
+    }
+
+    auto distance = [closestTo](double scale) { return std::abs(std::log(scale / closestTo)); };
+    std::sort(result.begin(), result.end(),
+              [&](double a, double b) { return distance(a) < distance(b); });
+    return result;
+}
+
+void TileCache::invalidate(const QString& layer, const QRectF& sceneRect)
+{
+    if (sceneRect.isNull()) {
+        return;
+    }
+
+    auto affected = [&](const Key& key) {
+        return key.layer == layer && tileRect(key.scale, key.x, key.y).intersects(sceneRect);
+    };
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (!affected(it.key())) {
+            ++it;
+        } else if (it->image.isNull()) {
+            it = m_tiles.erase(it);  // Nothing worth showing meanwhile
+        } else {
+            it->stale = true;
+            ++it;
+        }
+    }
+
+    // Renders already under way may predate the change; the next request
+    // for each tile gets a new ticket
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        it = affected(it.key()) ? m_pending.erase(it) : std::next(it);
+    }
+}
+
+bool TileCache::hasStale(const QString& layer, double scale, const QRectF& sceneRect) const
+{
+    if (sceneRect.isNull()) {
+        return false;
+    }
+
+    QRect range = tileRange(scale, sceneRect);
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+        for (int x = range.left(); x <= range.right(); ++x) {
+            auto it = m_tiles.constFind(Key{layer, scale, x, y});
+            if (it != m_tiles.constEnd() && it->stale) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TileCache::invalidateLayer(const QString& layer)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        it = (it.key().layer == layer) ? m_tiles.erase(it) : std::next(it);
+    }
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        it = (it.key().layer == layer) ? m_pending.erase(it) : std::next(it);
+    }
+}
+
+void TileCache::clear()
+{
+    m_tiles.clear();
+    m_pending.clear();
+}
+
+void TileCache::beginFrame()
+{
+    m_frameStart = m_useCounter + 1;
+}
+
+void TileCache::trim()
+{
+    if (m_tiles.size() <= m_maxTiles) {
+        return;
+    }
+
+    // Images and empty markers are trimmed against their own budgets;
+    // tiles of the current frame are not candidates
+    QVector<QPair<quint64, Key>> images;
+    QVector<QPair<quint64, Key>> empties;
+    int imageTotal = 0;
+    for (auto it = m_tiles.constBegin(); it != m_tiles.constEnd(); ++it) {
+        bool empty = it->image.isNull();
+        if (!empty) {
+            ++imageTotal;
+        }
+        if (it->lastUsed < m_frameStart) {
+            (empty ? empties : images).append(qMakePair(it->lastUsed, it.key()));
+        }
+    }
+
+    auto evictOldest = [this](QVector<QPair<quint64, Key>>& candidates, int excess) {
+        excess = qMin(excess, static_cast<int>(candidates.size()));
+        if (excess <= 0) {
+            return;
+        }
+        std::partial_sort(candidates.begin(), candidates.begin() + excess, candidates.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (int i = 0; i < excess; ++i) {
+            m_tiles.remove(candidates[i].second);
+        }
+    };
+    int emptyTotal = m_tiles.size() - imageTotal;
+    evictOldest(images, imageTotal - m_maxTiles);
+    evictOldest(empties, emptyTotal - m_maxTiles * EmptyTilesPerImage);
+}
+
+void TileCache::setMaxTiles(int maxTiles)
+{
+    m_maxTiles = qMax(1, maxTiles);
+    trim();
+}
+
+} // namespace UI
+} // namespace PatternCAD
@@ -0,0 +1,115 @@
+/**
+ * TileCache.h
+ *
+ * Raster tile cache for canvas rendering
+ */
+
+#ifndef PATTERNCAD_TILECACHE_H
+#define PATTERNCAD_TILECACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+namespace PatternCAD {
+namespace UI {
+
+/**
+ * TileCache stores rendered images of fixed-size screen tiles:
+ * - Tiles are keyed by layer, zoom scale and tile coordinates, so each layer
+ *   keeps its own backing images and zoom levels do not evict each other
+ * - Tile (x, y) at a scale covers the scene rect of TileSize device-
+ *   independent pixels starting at (x, y) * TileSize / scale
+ * - A null image records a tile known to be empty
+ * - Least recently used images are evicted beyond the capacity; empty
+ *   markers cost next to nothing and have a separate, larger allowance
+ * - Tiles used since the last beginFrame() are never evicted, so a frame
+ *   that needs more tiles than the capacity does not drop its own
+ * - Tiles rendered asynchronously are marked pending with a ticket; a
+ *   result is accepted only if the tile was not invalidated meanwhile
+ * - Invalidated tiles keep their image, marked stale, so it can be shown
+ *   until the re-rendered replacement is accepted
+ */
+class TileCache
+{
+public:
+    static constexpr int TileSize = 256;
+    static constexpr int EmptyTilesPerImage = 4;  // Empty markers allowed per image of capacity
+
+    struct Key {
+        QString layer;
+        double scale;
+        int x;
+        int y;
+
+        bool operator==(const Key& other) const {
+            return x == other.x && y == other.y && scale == other.scale && layer == other.layer;
+        }
+    };
+
+    explicit TileCache(int maxTiles = 256);
+
+    // Tile geometry
+    static QRectF tileRect(double scale, int x, int y);
+    static QRect tileRange(double scale, const QRectF& sceneRect);  // Inclusive tile coordinates
+
+    // Lookup (marks the tile as used) and insertion
+    bool find(const Key& key, QImage* image, bool* stale = nullptr);
+    bool peek(const Key& key, QImage* image) const;  // Does not mark as used
+    void insert(const Key& key, const QImage& image);
+
+    // Asynchronous rendering
+    bool isPending(const Key& key) const { return m_pending.contains(key); }
+    quint64 markPending(const Key& key);
+    bool completePending(const Key& key, quint64 ticket, const QImage& image);
+    void clearPending();
+
+    // Scales with cached tiles for a layer, closest to the given scale first
+    QVector<double> scales(const QString& layer, double closestTo) const;
+
+    // Mark the tiles of a layer overlapping a scene rect stale, at every
+    // scale, and drop their pending renders; empty markers are dropped
+    void invalidate(const QString& layer, const QRectF& sceneRect);
+    void invalidateLayer(const QString& layer);
+    void clear();
+
+    // Whether a tile of a layer at a scale overlapping a scene rect is stale
+    bool hasStale(const QString& layer, double scale, const QRectF& sceneRect) const;
+
+    // Start of a frame: tiles used from here on are kept by trim()
+    void beginFrame();
+
+    // Evict least recently used tiles down to the capacity
+    void trim();
+
+    int size() const { return m_tiles.size(); }
+    int maxTiles() const { return m_maxTiles; }
+    void setMaxTiles(int maxTiles);
+
+private:
+    struct Tile {
+        QImage image;
+        quint64 lastUsed;
+        bool stale;
+    };
+
+    QHash<Key, Tile> m_tiles;
+    QHash<Key, quint64> m_pending;
+    int m_maxTiles;
+    quint64 m_useCounter;
+    quint64 m_frameStart;
+    quint64 m_ticketCounter;
+};
+
+inline size_t qHash(const TileCache::Key& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.layer, key.scale, key.x, key.y);
+}
+
+} // namespace UI
+} // namespace PatternCAD
+
+#endif // PATTERNCAD_TILECACHE_H
@@ -5,9 +5,17 @@
  */
 
 #include <QtTest/QtTest>
+#include <QtMath>
 #include "../src/geometry/Point2D.h"
 #include "../src/geometry/Line.h"
 #include "../src/geometry/Circle.h"
+#include "../src/geometry/CurveSegment.h"
+#include "../src/geometry/ArcLengthIndex.h"
+#include "../src/geometry/AABBTree.h"
+#include "../src/geometry/PathSimplifier.h"
+#include "../src/geometry/PolygonContainment.h"
+#include "../src/geometry/SelfIntersectionFinder.h"
+#include "../src/geometry/VertexStore.h"
 
 using namespace PatternCAD::Geometry;
 
@@ -19,6 +27,19 @@ private slots:
     void test_Point2D_distance();
     void test_Line_length();
     void test_Circle_area();
+    void test_CurveSegment_length();
+    void test_CurveSegment_parameterAtFraction();
+    void test_CurveSegment_flatten();
+    void test_CurveSegment_closestPoint();
+    void test_CurveSegment_boundingRect();
+    void test_ArcLengthIndex_queries();
+    void test_AABBTree_queries();
+    void test_AABBTree_hitTolerance();
+    void test_PathSimplifier_simplify();
+    void test_PolygonContainment_contains();
+    void test_SelfIntersectionFinder_find();
+    void test_VertexStore_layout();
+    void test_GeometryObject_transform();
 };
 
 void GeometryTest::test_Point2D_distance()
@@ -46,5 +67,307 @@ void GeometryTest::test_Circle_area()
     QVERIFY(qAbs(area - 314.159) < 0.01);
 }
 
+void GeometryTest::test_CurveSegment_length()
+{
+    CurveSegment line(QPointF(0, 0), QPointF(3, 4));
+    QCOMPARE(line.length(), 5.0);
+
+    // Cubic approximation of a quarter circle of radius 100
+    const double k = 0.5522847498 * 100.0;
+    CurveSegment arc(QPointF(100, 0), QPointF(100, k), QPointF(k, 100), QPointF(0, 100));
+    QVERIFY(qAbs(arc.length(0.0001) - 157.1017) < 0.001);
+}
+
+void GeometryTest::test_CurveSegment_parameterAtFraction()
+{
+    const double k = 0.5522847498 * 100.0;
+    CurveSegment arc(QPointF(100, 0), QPointF(100, k), QPointF(k, 100), QPointF(0, 100));
+
+    double t = arc.parameterAtFraction(0.25, 0.0001);
+    QVERIFY(qAbs(arc.lengthAt(t, 0.0001) - arc.length(0.0001) * 0.25) < 0.001);
+    QVERIFY(qAbs(arc.fractionAtParameter(t, 0.0001) - 0.25) < 0.0001);
+}
+
+void GeometryTest::test_CurveSegment_flatten()
+{
+    QVector<QPointF> linePoints;
+    CurveSegment(QPointF(0, 0), QPointF(3, 4)).flatten(&linePoints, 0.01);
+    QCOMPARE(linePoints.size(), 1);
+    QCOMPARE(linePoints.first(), QPointF(3, 4));
+
+    const double k = 0.5522847498 * 100.0;
+    CurveSegment arc(QPointF(100, 0), QPointF(100, k), QPointF(k, 100), QPointF(0, 100));
+
+    QVector<QPointF> coarse;
+    QVector<QPointF> fine;
+    arc.flatten(&coarse, 1.0);
+    arc.flatten(&fine, 0.01);
+    QVERIFY(coarse.size() < fine.size());
+    QCOMPARE(fine.last(), QPointF(0, 100));
+
+    // Chord midpoints stay within the tolerance of the (near) circle
+    QPointF previous = arc.start();
+    for (const QPointF& point : fine) {
+        QPointF mid = (previous + point) * 0.5;
+        double radius = std::sqrt(mid.x() * mid.x() + mid.y() * mid.y());
+        QVERIFY(100.0 - radius < 0.01 + 0.03);  // 0.03: cubic vs. true circle error
+        previous = point;
+    }
+}
+
+void GeometryTest::test_CurveSegment_closestPoint()
+{
+    double t = 0.0;
+    double distance = 0.0;
+    QPointF onLine = CurveSegment(QPointF(0, 0), QPointF(10, 0)).closestPoint(QPointF(4, 3), &t, &distance);
+    QCOMPARE(onLine, QPointF(4, 0));
+    QCOMPARE(t, 0.4);
+    QCOMPARE(distance, 3.0);
+
+    const double k = 0.5522847498 * 100.0;
+    CurveSegment arc(QPointF(100, 0), QPointF(100, k), QPointF(k, 100), QPointF(0, 100));
+
+    // The refined point is a true foot point: the offset is perpendicular
+    // to the curve, which coarse sampling alone does not achieve
+    QPointF query(200, 50);
+    QPointF closest = arc.closestPoint(query, &t, &distance);
+    QPointF offset = closest - query;
+    QVERIFY(std::abs(QPointF::dotProduct(offset, arc.derivativeAt(t))) < 1e-6);
+    QVERIFY(std::abs(distance - std::sqrt(QPointF::dotProduct(offset, offset))) < 1e-9);
+    QVERIFY(t > 0.0 && t < 0.5);
+
+    // Beyond the end the nearest point clamps to the end point
+    arc.closestPoint(QPointF(-50, 150), &t);
+    QCOMPARE(t, 1.0);
+}
+
+void GeometryTest::test_CurveSegment_boundingRect()
+{
+    QCOMPARE(CurveSegment(QPointF(10, 5), QPointF(0, 20)).boundingRect(), QRectF(0, 5, 10, 15));
+
+    // Arch: the apex at t = 0.5 reaches 3/4 of the control height, beyond
+    // the end points but short of the control polygon
+    CurveSegment arch(QPointF(0, 0), QPointF(0, 100), QPointF(100, 100), QPointF(100, 0));
+    QRectF bounds = arch.boundingRect();
+    QCOMPARE(bounds.left(), 0.0);
+    QCOMPARE(bounds.right(), 100.0);
+    QCOMPARE(bounds.top(), 0.0);
+    QVERIFY(std::abs(bounds.bottom() - 75.0) < 1e-9);
+
+    // Every flattened point lies inside, at any tolerance
+    QVector<QPointF> points;
+    arch.flatten(&points, 0.001);
+    for (const QPointF& point : points) {
+        QVERIFY(bounds.adjusted(-1e-9, -1e-9, 1e-9, 1e-9).contains(point));
+    }
+}
+
+void GeometryTest::test_ArcLengthIndex_queries()
+{
+    ArcLengthIndex index;
+    index.build({10.0, 20.0, 30.0, 40.0});
+    QCOMPARE(index.total(), 100.0);
+    QCOMPARE(index.prefix(2), 30.0);
+
+    double offset = 0.0;
+    QCOMPARE(index.find(35.0, &offset), 2);
+    QCOMPARE(offset, 5.0);
+
+    index.setLength(1, 5.0);
+    QCOMPARE(index.total(), 85.0);
+    QCOMPARE(index.find(50.0, &offset), 3);
+    QCOMPARE(offset, 5.0);
+}
+
+void GeometryTest::test_AABBTree_queries()
+{
+    AABBTree tree;
+    int a = tree.insert(QRectF(0, 0, 10, 10), nullptr);
+    int b = tree.insert(QRectF(20, 0, 10, 10), nullptr);
+    int c = tree.insert(QRectF(0, 20, 30, 0), nullptr);  // Degenerate (horizontal line)
+    QCOMPARE(tree.size(), 3);
+    QCOMPARE(tree.totalBounds(), QRectF(0, 0, 30, 20));
+
+    QCOMPARE(tree.queryPoint(QPointF(5, 5)), QVector<int>{a});
+    QCOMPARE(tree.queryPoint(QPointF(15, 20)), QVector<int>{c});
+    QCOMPARE(tree.queryPoint(QPointF(15, 5), 6.0).size(), 2);
+    QCOMPARE(tree.nearest(QPointF(26, 12), 1), QVector<int>{b});
+
+    tree.update(b, QRectF(100, 100, 5, 5));
+    QVERIFY(tree.query(QRectF(20, 0, 10, 10)).isEmpty());
+    QCOMPARE(tree.totalBounds(), QRectF(0, 0, 105, 105));
+
+    tree.remove(a);
+    QCOMPARE(tree.size(), 2);
+    QVERIFY(tree.queryPoint(QPointF(5, 5)).isEmpty());
+}
+
+void GeometryTest::test_AABBTree_hitTolerance()
+{
+    // Clicks within pick reach but outside the indexed bounds still find
+    // the object when queried with the largest hit tolerance
+    Line line(QPointF(0, 0), QPointF(100, 0));
+    Circle circle(QPointF(200, 0), 20.0);
+    Point2D point(QPointF(0, 50));
+    AABBTree tree;
+    int lineProxy = tree.insert(line.boundingRect(), &line);
+    int circleProxy = tree.insert(circle.boundingRect(), &circle);
+    int pointProxy = tree.insert(point.boundingRect(), &point);
+
+    QPointF offLine(50, 4);
+    QPointF offCircle(224, 0);
+    QPointF offPoint(0, 57);
+    QVERIFY(!line.boundingRect().contains(offLine) && line.contains(offLine));
+    QVERIFY(!circle.boundingRect().contains(offCircle) && circle.contains(offCircle));
+    QVERIFY(!point.boundingRect().contains(offPoint) && point.contains(offPoint));
+
+    QCOMPARE(tree.queryPoint(offLine, GeometryObject::MaxHitTolerance), QVector<int>{lineProxy});
+    QCOMPARE(tree.queryPoint(offCircle, GeometryObject::MaxHitTolerance), QVector<int>{circleProxy});
+    QCOMPARE(tree.queryPoint(offPoint, GeometryObject::MaxHitTolerance), QVector<int>{pointProxy});
+}
+
+void GeometryTest::test_PolygonContainment_contains()
+{
+    // Concave "U": the notch between the arms is outside
+    QPolygonF u;
+    u << QPointF(0, 0) << QPointF(30, 0) << QPointF(30, 30) << QPointF(20, 30)
+      << QPointF(20, 10) << QPointF(10, 10) << QPointF(10, 30) << QPointF(0, 30);
+    PolygonContainment containment;
+    containment.build(u);
+    QCOMPARE(containment.bounds(), QRectF(0, 0, 30, 30));
+    QVERIFY(containment.contains(QPointF(5, 20)));
+    QVERIFY(containment.contains(QPointF(15, 5)));
+    QVERIFY(!containment.contains(QPointF(15, 20)));
+    QVERIFY(!containment.contains(QPointF(40, 5)));
+    QVERIFY(containment.contains(QPointF(5, 10)));  // Ray through two vertices
+
+    // Pentagram: the center is wound twice, so only the winding rule fills it
+    QPolygonF star;
+    for (int i = 0; i < 5; ++i) {
+        double angle = qDegreesToRadians(-90.0 + i * 144.0);
+        star << QPointF(100 * std::cos(angle), 100 * std::sin(angle));
+    }
+    containment.build(star);
+    QCOMPARE(qAbs(containment.windingNumber(QPointF(0, 0))), 2);
+    QVERIFY(!containment.contains(QPointF(0, 0)));
+    QVERIFY(containment.contains(QPointF(0, 0), Qt::WindingFill));
+    QVERIFY(containment.contains(QPointF(0, -80)));
+}
+
+void GeometryTest::test_SelfIntersectionFinder_find()
+{
+    QPolygonF square;
+    square << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10);
+    QVERIFY(SelfIntersectionFinder::find(square, true).isEmpty());
+
+    // Bow tie: the first and third edges cross in the middle
+    QPolygonF bowTie;
+    bowTie << QPointF(0, 0) << QPointF(10, 10) << QPointF(10, 0) << QPointF(0, 10);
+    QVector<EdgeIntersection> hits = SelfIntersectionFinder::find(bowTie, true);
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits[0].firstEdge, 0);
+    QCOMPARE(hits[0].secondEdge, 2);
+    QCOMPARE(hits[0].point, QPointF(5, 5));
+    QVERIFY(!hits[0].overlap);
+    QVERIFY(SelfIntersectionFinder::find(bowTie, false).size() == 1);
+
+    // A spike folds back over its own edge, and its tip touches edge 0
+    QPolygonF spike;
+    spike << QPointF(0, 0) << QPointF(10, 0) << QPointF(5, 0) << QPointF(5, 5);
+    hits = SelfIntersectionFinder::find(spike, true);
+    QCOMPARE(hits.size(), 2);
+    QCOMPARE(hits[0].secondEdge, 1);
+    QVERIFY(hits[0].overlap);
+    QCOMPARE(hits[1].secondEdge, 2);
+    QCOMPARE(hits[1].point, QPointF(5, 0));
+}
+
+void GeometryTest::test_VertexStore_layout()
+{
+    VertexStore store;
+    store.append(PolylineVertex(QPointF(0, 0)));
+    store.append(PolylineVertex(QPointF(10, 0)));
+    store.append(PolylineVertex(QPointF(10, 10)));
+    QCOMPARE(store.size(), 3);
+    QCOMPARE(store.smoothCount(), 0);
+    QCOMPARE(store.bounds(), QRectF(0, 0, 10, 10));
+    QCOMPARE(store.signedArea(), 50.0);
+    QCOMPARE(store.chordLengths(false), (QVector<double>{10.0, 10.0}));
+
+    // Curve data round-trips once a vertex departs from the defaults
+    store.insert(1, PolylineVertex(QPointF(5, -5), VertexType::Smooth, 0.25, 0.75, QPointF(1, 0)));
+    QCOMPARE(store.size(), 4);
+    QCOMPARE(store.smoothCount(), 1);
+    QVERIFY(store.isSmooth(1));
+    QVERIFY(!store.isSmooth(2));
+    QCOMPARE(store.incomingTension(1), 0.25);
+    QCOMPARE(store.outgoingTension(1), 0.75);
+    QCOMPARE(store.tangent(1), QPointF(1, 0));
+    QCOMPARE(store.outgoingTension(3), 0.5);
+    QCOMPARE(store.position(3), QPointF(10, 10));
+
+    VertexStore copy(store.toVector());
+    QCOMPARE(copy.positions(), store.positions());
+    QCOMPARE(copy.tangent(1), QPointF(1, 0));
+
+    store.transform(QTransform().translate(1, 2).rotate(90));
+    QCOMPARE(store.position(2), QPointF(1, 12));
+    QVERIFY(qAbs(store.tangent(1).x()) < 1e-12);
+    QCOMPARE(store.tangent(1).y(), 1.0);
+
+    store.remove(1);
+    QCOMPARE(store.size(), 3);
+    QCOMPARE(store.smoothCount(), 0);
+    QVERIFY(!store.isSmooth(1));
+}
+
+void GeometryTest::test_PathSimplifier_simplify()
+{
+    // Nearly straight run with one real corner
+    QPolygonF open;
+    open << QPointF(0, 0) << QPointF(5, 0.1) << QPointF(10, 0) << QPointF(10, 10);
+    QPolygonF simplified = PathSimplifier::simplify(open, 0.5);
+    QCOMPARE(simplified.size(), 3);
+    QCOMPARE(simplified[1], QPointF(10, 0));
+    QCOMPARE(PathSimplifier::simplify(open, 0.05).size(), 4);
+
+    // Closed square with midpoints keeps its corners
+    QPolygonF square;
+    square << QPointF(0, 0) << QPointF(5, 0) << QPointF(10, 0) << QPointF(10, 5)
+           << QPointF(10, 10) << QPointF(5, 10) << QPointF(0, 10) << QPointF(0, 5);
+    simplified = PathSimplifier::simplifyClosed(square, 0.5);
+    QCOMPARE(simplified.size(), 4);
+    QVERIFY(simplified.contains(QPointF(10, 0)));
+    QVERIFY(simplified.contains(QPointF(0, 10)));
+}
+
+void GeometryTest::test_GeometryObject_transform()
+{
+    auto near = [](const QPointF& a, const QPointF& b) {
+        return qAbs(a.x() - b.x()) < 1e-9 && qAbs(a.y() - b.y()) < 1e-9;
+    };
+
+    // Matrices agree with the per-point operations
+    Line rotated(QPointF(1, 0), QPointF(3, 2));
+    Line transformed(QPointF(1, 0), QPointF(3, 2));
+    rotated.rotate(90.0, QPointF(1, 1));
+    transformed.transform(GeometryObject::rotationTransform(90.0, QPointF(1, 1)));
+    QVERIFY(near(transformed.start(), rotated.start()));
+    QVERIFY(near(transformed.end(), rotated.end()));
+    QVERIFY(near(transformed.start(), QPointF(2, 1)));
+
+    // Mirror across the diagonal swaps coordinates
+    Point2D point(3, 1);
+    point.transform(GeometryObject::mirrorTransform(QPointF(0, 0), QPointF(2, 2)));
+    QVERIFY(near(point.position(), QPointF(1, 3)));
+
+    // Scale about an origin
+    point.transform(GeometryObject::scaleTransform(2.0, 0.5, QPointF(1, 1)));
+    QVERIFY(near(point.position(), QPointF(1, 2)));
+
+    // Degenerate mirror axis leaves the object in place
+    QVERIFY(GeometryObject::mirrorTransform(QPointF(1, 1), QPointF(1, 1)).isIdentity());
+}
+
 QTEST_MAIN(GeometryTest)
 #include "test_geometry.moc"